@@ -0,0 +1,507 @@
+/*
+ * Copyright (c) 2016 Simon Schoenenberger
+ * https://github.com/detomon/number_parser
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include <math.h>
+#include <stddef.h>
+#include "number_parser.h"
+#include "number_internal.h"
+
+#define MAX_INT ((uint64_t) INT64_MAX + 1)
+
+#define X 0xFF
+#define DIGITS_10 0, 1, 2, 3, 4, 5, 6, 7, 8, 9
+#define DIGITS_36 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, \
+	26, 27, 28, 29, 30, 31, 32, 33, 34, 35
+
+/**
+ * Maps characters to digit values; invalid characters are mapped to 0xFF.
+ */
+static const uint8_t digit_values[256] = {
+	X, X, X, X, X, X, X, X, X, X, X, X, X, X, X, X,
+	X, X, X, X, X, X, X, X, X, X, X, X, X, X, X, X,
+	X, X, X, X, X, X, X, X, X, X, X, X, X, X, X, X,
+	DIGITS_10, X, X, X, X, X, X,
+	X, DIGITS_36, X, X, X, X, X,
+	X, DIGITS_36, X, X, X, X, X,
+	X, X, X, X, X, X, X, X, X, X, X, X, X, X, X, X,
+	X, X, X, X, X, X, X, X, X, X, X, X, X, X, X, X,
+	X, X, X, X, X, X, X, X, X, X, X, X, X, X, X, X,
+	X, X, X, X, X, X, X, X, X, X, X, X, X, X, X, X,
+	X, X, X, X, X, X, X, X, X, X, X, X, X, X, X, X,
+	X, X, X, X, X, X, X, X, X, X, X, X, X, X, X, X,
+	X, X, X, X, X, X, X, X, X, X, X, X, X, X, X, X,
+	X, X, X, X, X, X, X, X, X, X, X, X, X, X, X, X,
+};
+
+#undef X
+#undef DIGITS_10
+#undef DIGITS_36
+
+const uint8_t* const number_digit_values = digit_values;
+
+// `base` ^ (2 ^ i) computed by repeated squaring like number_parser_end() for
+// the bases which are scaled by powers; bases 37 and above square at runtime
+
+static const double pows_3[NUMBER_BASE_POWS] = {
+	0x1.8p+1, 0x1.2p+3, 0x1.44p+6, 0x1.9a1p+12,
+	0x1.486ba08p+25, 0x1.a553f8878fa04p+50, 0x1.5ab6a57c7bc99p+101, 0x1.d59239a436969p+202,
+	0x1.aea88d5cbe264p+405, 0x1.6a3d54eeb348bp+811, INFINITY, INFINITY,
+};
+
+static const double pows_5[NUMBER_BASE_POWS] = {
+	0x1.4p+2, 0x1.9p+4, 0x1.388p+9, 0x1.7d784p+18,
+	0x1.1c37937e08p+37, 0x1.3b8b5b5056e17p+74, 0x1.84f03e93ff9f6p+148, 0x1.27748f9301d33p+297,
+	0x1.54fdd7f73bf3fp+594, INFINITY, INFINITY, INFINITY,
+};
+
+static const double pows_6[NUMBER_BASE_POWS] = {
+	0x1.8p+2, 0x1.2p+5, 0x1.44p+10, 0x1.9a1p+20,
+	0x1.486ba08p+41, 0x1.a553f8878fa04p+82, 0x1.5ab6a57c7bc99p+165, 0x1.d59239a436969p+330,
+	0x1.aea88d5cbe264p+661, INFINITY, INFINITY, INFINITY,
+};
+
+static const double pows_7[NUMBER_BASE_POWS] = {
+	0x1.cp+2, 0x1.88p+5, 0x1.2c2p+11, 0x1.5fdb04p+22,
+	0x1.e39a5057d81p+44, 0x1.c8c7d4181e19bp+89, 0x1.97843fc8ac392p+179, 0x1.445ae390f539dp+359,
+	0x1.9af6304bb8f13p+718, INFINITY, INFINITY, INFINITY,
+};
+
+static const double pows_9[NUMBER_BASE_POWS] = {
+	0x1.2p+3, 0x1.44p+6, 0x1.9a1p+12, 0x1.486ba08p+25,
+	0x1.a553f8878fa04p+50, 0x1.5ab6a57c7bc99p+101, 0x1.d59239a436969p+202, 0x1.aea88d5cbe264p+405,
+	0x1.6a3d54eeb348bp+811, INFINITY, INFINITY, INFINITY,
+};
+
+static const double pows_11[NUMBER_BASE_POWS] = {
+	0x1.6p+3, 0x1.e4p+6, 0x1.c988p+13, 0x1.98db6c2p+27,
+	0x1.467e125c16358p+55, 0x1.a06554d89c873p+110, 0x1.52a4bdee05e0ep+221, 0x1.bff76f8c6d66bp+442,
+	0x1.87f1035a6bd16p+885, INFINITY, INFINITY, INFINITY,
+};
+
+static const double pows_12[NUMBER_BASE_POWS] = {
+	0x1.8p+3, 0x1.2p+7, 0x1.44p+14, 0x1.9a1p+28,
+	0x1.486ba08p+57, 0x1.a553f8878fa04p+114, 0x1.5ab6a57c7bc99p+229, 0x1.d59239a436969p+458,
+	0x1.aea88d5cbe264p+917, INFINITY, INFINITY, INFINITY,
+};
+
+static const double pows_13[NUMBER_BASE_POWS] = {
+	0x1.ap+3, 0x1.52p+7, 0x1.be44p+14, 0x1.84f88108p+29,
+	0x1.27811c2d40449p+59, 0x1.551ad00db2d2bp+118, 0x1.c68071136a43ep+236, 0x1.9375e8c111229p+473,
+	0x1.3dee388f38058p+947, INFINITY, INFINITY, INFINITY,
+};
+
+static const double pows_14[NUMBER_BASE_POWS] = {
+	0x1.cp+3, 0x1.88p+7, 0x1.2c2p+15, 0x1.5fdb04p+30,
+	0x1.e39a5057d81p+60, 0x1.c8c7d4181e19bp+121, 0x1.97843fc8ac392p+243, 0x1.445ae390f539dp+487,
+	0x1.9af6304bb8f13p+974, INFINITY, INFINITY, INFINITY,
+};
+
+static const double pows_15[NUMBER_BASE_POWS] = {
+	0x1.ep+3, 0x1.c2p+7, 0x1.8b82p+15, 0x1.31853702p+31,
+	0x1.6c9eb264f7e5ep+62, 0x1.03a9d6d7e8f42p+125, 0x1.076119663ebd4p+250, 0x1.0ef8a70456e98p+500,
+	0x1.1ed171d12cb39p+1000, INFINITY, INFINITY, INFINITY,
+};
+
+static const double pows_17[NUMBER_BASE_POWS] = {
+	0x1.1p+4, 0x1.21p+8, 0x1.4641p+16, 0x1.9fc99c81p+32,
+	0x1.51a7a418b01fcp+65, 0x1.bd5acbd08119p+130, 0x1.8362646368d8p+261, 0x1.251950aac93b9p+523,
+	INFINITY, INFINITY, INFINITY, INFINITY,
+};
+
+static const double pows_18[NUMBER_BASE_POWS] = {
+	0x1.2p+4, 0x1.44p+8, 0x1.9a1p+16, 0x1.486ba08p+33,
+	0x1.a553f8878fa04p+66, 0x1.5ab6a57c7bc99p+133, 0x1.d59239a436969p+266, 0x1.aea88d5cbe264p+533,
+	INFINITY, INFINITY, INFINITY, INFINITY,
+};
+
+static const double pows_19[NUMBER_BASE_POWS] = {
+	0x1.3p+4, 0x1.69p+8, 0x1.fd11p+16, 0x1.fa264d908p+33,
+	0x1.f45db82d2c332p+67, 0x1.e8ff1cdfe4fd6p+135, 0x1.d306ce281128fp+271, 0x1.aa00ea2a3f405p+543,
+	INFINITY, INFINITY, INFINITY, INFINITY,
+};
+
+static const double pows_20[NUMBER_BASE_POWS] = {
+	0x1.4p+4, 0x1.9p+8, 0x1.388p+17, 0x1.7d784p+34,
+	0x1.1c37937e08p+69, 0x1.3b8b5b5056e17p+138, 0x1.84f03e93ff9f6p+276, 0x1.27748f9301d33p+553,
+	INFINITY, INFINITY, INFINITY, INFINITY,
+};
+
+static const double pows_21[NUMBER_BASE_POWS] = {
+	0x1.5p+4, 0x1.b9p+8, 0x1.7bd88p+17, 0x1.19cd610c2p+35,
+	0x1.363483d130757p+70, 0x1.77e33a047237ep+140, 0x1.13f5bed47bd42p+281, 0x1.2979e3e352feep+562,
+	INFINITY, INFINITY, INFINITY, INFINITY,
+};
+
+static const double pows_22[NUMBER_BASE_POWS] = {
+	0x1.6p+4, 0x1.e4p+8, 0x1.c988p+17, 0x1.98db6c2p+35,
+	0x1.467e125c16358p+71, 0x1.a06554d89c873p+142, 0x1.52a4bdee05e0ep+285, 0x1.bff76f8c6d66bp+570,
+	INFINITY, INFINITY, INFINITY, INFINITY,
+};
+
+static const double pows_23[NUMBER_BASE_POWS] = {
+	0x1.7p+4, 0x1.088p+9, 0x1.11484p+18, 0x1.23bb2ce41p+36,
+	0x1.4c7310e9196e9p+72, 0x1.afbaa794cc819p+144, 0x1.6c0b042f7d447p+289, 0x1.02d7aa3034307p+579,
+	INFINITY, INFINITY, INFINITY, INFINITY,
+};
+
+static const double pows_24[NUMBER_BASE_POWS] = {
+	0x1.8p+4, 0x1.2p+9, 0x1.44p+18, 0x1.9a1p+36,
+	0x1.486ba08p+73, 0x1.a553f8878fa04p+146, 0x1.5ab6a57c7bc99p+293, 0x1.d59239a436969p+586,
+	INFINITY, INFINITY, INFINITY, INFINITY,
+};
+
+static const double pows_25[NUMBER_BASE_POWS] = {
+	0x1.9p+4, 0x1.388p+9, 0x1.7d784p+18, 0x1.1c37937e08p+37,
+	0x1.3b8b5b5056e17p+74, 0x1.84f03e93ff9f6p+148, 0x1.27748f9301d33p+297, 0x1.54fdd7f73bf3fp+594,
+	INFINITY, INFINITY, INFINITY, INFINITY,
+};
+
+static const double pows_26[NUMBER_BASE_POWS] = {
+	0x1.ap+4, 0x1.52p+9, 0x1.be44p+18, 0x1.84f88108p+37,
+	0x1.27811c2d40449p+75, 0x1.551ad00db2d2bp+150, 0x1.c68071136a43ep+300, 0x1.9375e8c111229p+601,
+	INFINITY, INFINITY, INFINITY, INFINITY,
+};
+
+static const double pows_27[NUMBER_BASE_POWS] = {
+	0x1.bp+4, 0x1.6c8p+9, 0x1.037e2p+19, 0x1.070872e384p+38,
+	0x1.0e425c56daffbp+76, 0x1.1d500bfaf40adp+152, 0x1.3dfb53b440c82p+304, 0x1.8af86409a7451p+608,
+	INFINITY, INFINITY, INFINITY, INFINITY,
+};
+
+static const double pows_28[NUMBER_BASE_POWS] = {
+	0x1.cp+4, 0x1.88p+9, 0x1.2c2p+19, 0x1.5fdb04p+38,
+	0x1.e39a5057d81p+76, 0x1.c8c7d4181e19bp+153, 0x1.97843fc8ac392p+307, 0x1.445ae390f539dp+615,
+	INFINITY, INFINITY, INFINITY, INFINITY,
+};
+
+static const double pows_29[NUMBER_BASE_POWS] = {
+	0x1.dp+4, 0x1.a48p+9, 0x1.595a2p+19, 0x1.d1e409fa84p+38,
+	0x1.a7ef1bb0ed136p+77, 0x1.5f04066bb367cp+155, 0x1.e14c09ab897d5p+310, 0x1.c46f69762c7p+621,
+	INFINITY, INFINITY, INFINITY, INFINITY,
+};
+
+static const double pows_30[NUMBER_BASE_POWS] = {
+	0x1.ep+4, 0x1.c2p+9, 0x1.8b82p+19, 0x1.31853702p+39,
+	0x1.6c9eb264f7e5ep+78, 0x1.03a9d6d7e8f42p+157, 0x1.076119663ebd4p+314, 0x1.0ef8a70456e98p+628,
+	INFINITY, INFINITY, INFINITY, INFINITY,
+};
+
+static const double pows_31[NUMBER_BASE_POWS] = {
+	0x1.fp+4, 0x1.e08p+9, 0x1.c2f02p+19, 0x1.8d2888de02p+39,
+	0x1.34135f75d060ap+79, 0x1.72be9f2acc7e1p+158, 0x1.0c75c9042ecd1p+317, 0x1.1986d3121da7bp+634,
+	INFINITY, INFINITY, INFINITY, INFINITY,
+};
+
+static const double pows_33[NUMBER_BASE_POWS] = {
+	0x1.08p+5, 0x1.104p+10, 0x1.21881p+20, 0x1.47747c7101p+40,
+	0x1.a2dacae9b3749p+80, 0x1.56a79cd0b271fp+161, 0x1.caa444bb95204p+322, 0x1.9ad817abaa315p+645,
+	INFINITY, INFINITY, INFINITY, INFINITY,
+};
+
+static const double pows_34[NUMBER_BASE_POWS] = {
+	0x1.1p+5, 0x1.21p+10, 0x1.4641p+20, 0x1.9fc99c81p+40,
+	0x1.51a7a418b01fcp+81, 0x1.bd5acbd08119p+162, 0x1.8362646368d8p+325, 0x1.251950aac93b9p+651,
+	INFINITY, INFINITY, INFINITY, INFINITY,
+};
+
+static const double pows_35[NUMBER_BASE_POWS] = {
+	0x1.18p+5, 0x1.324p+10, 0x1.6e5d1p+20, 0x1.06271dca508p+41,
+	0x1.0c7416f433e2p+82, 0x1.198344b41bff1p+164, 0x1.35917022c83acp+328, 0x1.76586b542fe32p+656,
+	INFINITY, INFINITY, INFINITY, INFINITY,
+};
+
+static const double pows_36[NUMBER_BASE_POWS] = {
+	0x1.2p+5, 0x1.44p+10, 0x1.9a1p+20, 0x1.486ba08p+41,
+	0x1.a553f8878fa04p+82, 0x1.5ab6a57c7bc99p+165, 0x1.d59239a436969p+330, 0x1.aea88d5cbe264p+661,
+	INFINITY, INFINITY, INFINITY, INFINITY,
+};
+
+// {max_mul, chunk_mul, digits, pows, base, safe_len, chunk_len}; `safe_len` is
+// the largest n with base ^ n <= 2 ^ 63, `chunk_len` the largest k with
+// base ^ k <= 2 ^ 32
+const number_base number_bases[256] = {
+	{0}, // invalid
+	{0}, // invalid
+	{MAX_INT / 2, 4294967296u, digit_values, NULL, 2, 63, 32},
+	{MAX_INT / 3, 3486784401u, digit_values, pows_3, 3, 39, 20},
+	{MAX_INT / 4, 4294967296u, digit_values, NULL, 4, 31, 16},
+	{MAX_INT / 5, 1220703125u, digit_values, pows_5, 5, 27, 13},
+	{MAX_INT / 6, 2176782336u, digit_values, pows_6, 6, 24, 12},
+	{MAX_INT / 7, 1977326743u, digit_values, pows_7, 7, 22, 11},
+	{MAX_INT / 8, 1073741824u, digit_values, NULL, 8, 21, 10},
+	{MAX_INT / 9, 3486784401u, digit_values, pows_9, 9, 19, 10},
+	{MAX_INT / 10, 1000000000u, digit_values, NULL, 10, 18, 9},
+	{MAX_INT / 11, 2357947691u, digit_values, pows_11, 11, 18, 9},
+	{MAX_INT / 12, 429981696u, digit_values, pows_12, 12, 17, 8},
+	{MAX_INT / 13, 815730721u, digit_values, pows_13, 13, 17, 8},
+	{MAX_INT / 14, 1475789056u, digit_values, pows_14, 14, 16, 8},
+	{MAX_INT / 15, 2562890625u, digit_values, pows_15, 15, 16, 8},
+	{MAX_INT / 16, 4294967296u, digit_values, NULL, 16, 15, 8},
+	{MAX_INT / 17, 410338673u, digit_values, pows_17, 17, 15, 7},
+	{MAX_INT / 18, 612220032u, digit_values, pows_18, 18, 15, 7},
+	{MAX_INT / 19, 893871739u, digit_values, pows_19, 19, 14, 7},
+	{MAX_INT / 20, 1280000000u, digit_values, pows_20, 20, 14, 7},
+	{MAX_INT / 21, 1801088541u, digit_values, pows_21, 21, 14, 7},
+	{MAX_INT / 22, 2494357888u, digit_values, pows_22, 22, 14, 7},
+	{MAX_INT / 23, 3404825447u, digit_values, pows_23, 23, 13, 7},
+	{MAX_INT / 24, 191102976u, digit_values, pows_24, 24, 13, 6},
+	{MAX_INT / 25, 244140625u, digit_values, pows_25, 25, 13, 6},
+	{MAX_INT / 26, 308915776u, digit_values, pows_26, 26, 13, 6},
+	{MAX_INT / 27, 387420489u, digit_values, pows_27, 27, 13, 6},
+	{MAX_INT / 28, 481890304u, digit_values, pows_28, 28, 13, 6},
+	{MAX_INT / 29, 594823321u, digit_values, pows_29, 29, 12, 6},
+	{MAX_INT / 30, 729000000u, digit_values, pows_30, 30, 12, 6},
+	{MAX_INT / 31, 887503681u, digit_values, pows_31, 31, 12, 6},
+	{MAX_INT / 32, 1073741824u, digit_values, NULL, 32, 12, 6},
+	{MAX_INT / 33, 1291467969u, digit_values, pows_33, 33, 12, 6},
+	{MAX_INT / 34, 1544804416u, digit_values, pows_34, 34, 12, 6},
+	{MAX_INT / 35, 1838265625u, digit_values, pows_35, 35, 12, 6},
+	{MAX_INT / 36, 2176782336u, digit_values, pows_36, 36, 12, 6},
+	{MAX_INT / 37, 2565726409u, digit_values, NULL, 37, 12, 6},
+	{MAX_INT / 38, 3010936384u, digit_values, NULL, 38, 12, 6},
+	{MAX_INT / 39, 3518743761u, digit_values, NULL, 39, 11, 6},
+	{MAX_INT / 40, 4096000000u, digit_values, NULL, 40, 11, 6},
+	{MAX_INT / 41, 115856201u, digit_values, NULL, 41, 11, 5},
+	{MAX_INT / 42, 130691232u, digit_values, NULL, 42, 11, 5},
+	{MAX_INT / 43, 147008443u, digit_values, NULL, 43, 11, 5},
+	{MAX_INT / 44, 164916224u, digit_values, NULL, 44, 11, 5},
+	{MAX_INT / 45, 184528125u, digit_values, NULL, 45, 11, 5},
+	{MAX_INT / 46, 205962976u, digit_values, NULL, 46, 11, 5},
+	{MAX_INT / 47, 229345007u, digit_values, NULL, 47, 11, 5},
+	{MAX_INT / 48, 254803968u, digit_values, NULL, 48, 11, 5},
+	{MAX_INT / 49, 282475249u, digit_values, NULL, 49, 11, 5},
+	{MAX_INT / 50, 312500000u, digit_values, NULL, 50, 11, 5},
+	{MAX_INT / 51, 345025251u, digit_values, NULL, 51, 11, 5},
+	{MAX_INT / 52, 380204032u, digit_values, NULL, 52, 11, 5},
+	{MAX_INT / 53, 418195493u, digit_values, NULL, 53, 10, 5},
+	{MAX_INT / 54, 459165024u, digit_values, NULL, 54, 10, 5},
+	{MAX_INT / 55, 503284375u, digit_values, NULL, 55, 10, 5},
+	{MAX_INT / 56, 550731776u, digit_values, NULL, 56, 10, 5},
+	{MAX_INT / 57, 601692057u, digit_values, NULL, 57, 10, 5},
+	{MAX_INT / 58, 656356768u, digit_values, NULL, 58, 10, 5},
+	{MAX_INT / 59, 714924299u, digit_values, NULL, 59, 10, 5},
+	{MAX_INT / 60, 777600000u, digit_values, NULL, 60, 10, 5},
+	{MAX_INT / 61, 844596301u, digit_values, NULL, 61, 10, 5},
+	{MAX_INT / 62, 916132832u, digit_values, NULL, 62, 10, 5},
+	{MAX_INT / 63, 992436543u, digit_values, NULL, 63, 10, 5},
+	{MAX_INT / 64, 1073741824u, digit_values, NULL, 64, 10, 5},
+	{MAX_INT / 65, 1160290625u, digit_values, NULL, 65, 10, 5},
+	{MAX_INT / 66, 1252332576u, digit_values, NULL, 66, 10, 5},
+	{MAX_INT / 67, 1350125107u, digit_values, NULL, 67, 10, 5},
+	{MAX_INT / 68, 1453933568u, digit_values, NULL, 68, 10, 5},
+	{MAX_INT / 69, 1564031349u, digit_values, NULL, 69, 10, 5},
+	{MAX_INT / 70, 1680700000u, digit_values, NULL, 70, 10, 5},
+	{MAX_INT / 71, 1804229351u, digit_values, NULL, 71, 10, 5},
+	{MAX_INT / 72, 1934917632u, digit_values, NULL, 72, 10, 5},
+	{MAX_INT / 73, 2073071593u, digit_values, NULL, 73, 10, 5},
+	{MAX_INT / 74, 2219006624u, digit_values, NULL, 74, 10, 5},
+	{MAX_INT / 75, 2373046875u, digit_values, NULL, 75, 10, 5},
+	{MAX_INT / 76, 2535525376u, digit_values, NULL, 76, 10, 5},
+	{MAX_INT / 77, 2706784157u, digit_values, NULL, 77, 10, 5},
+	{MAX_INT / 78, 2887174368u, digit_values, NULL, 78, 10, 5},
+	{MAX_INT / 79, 3077056399u, digit_values, NULL, 79, 9, 5},
+	{MAX_INT / 80, 3276800000u, digit_values, NULL, 80, 9, 5},
+	{MAX_INT / 81, 3486784401u, digit_values, NULL, 81, 9, 5},
+	{MAX_INT / 82, 3707398432u, digit_values, NULL, 82, 9, 5},
+	{MAX_INT / 83, 3939040643u, digit_values, NULL, 83, 9, 5},
+	{MAX_INT / 84, 4182119424u, digit_values, NULL, 84, 9, 5},
+	{MAX_INT / 85, 52200625u, digit_values, NULL, 85, 9, 4},
+	{MAX_INT / 86, 54700816u, digit_values, NULL, 86, 9, 4},
+	{MAX_INT / 87, 57289761u, digit_values, NULL, 87, 9, 4},
+	{MAX_INT / 88, 59969536u, digit_values, NULL, 88, 9, 4},
+	{MAX_INT / 89, 62742241u, digit_values, NULL, 89, 9, 4},
+	{MAX_INT / 90, 65610000u, digit_values, NULL, 90, 9, 4},
+	{MAX_INT / 91, 68574961u, digit_values, NULL, 91, 9, 4},
+	{MAX_INT / 92, 71639296u, digit_values, NULL, 92, 9, 4},
+	{MAX_INT / 93, 74805201u, digit_values, NULL, 93, 9, 4},
+	{MAX_INT / 94, 78074896u, digit_values, NULL, 94, 9, 4},
+	{MAX_INT / 95, 81450625u, digit_values, NULL, 95, 9, 4},
+	{MAX_INT / 96, 84934656u, digit_values, NULL, 96, 9, 4},
+	{MAX_INT / 97, 88529281u, digit_values, NULL, 97, 9, 4},
+	{MAX_INT / 98, 92236816u, digit_values, NULL, 98, 9, 4},
+	{MAX_INT / 99, 96059601u, digit_values, NULL, 99, 9, 4},
+	{MAX_INT / 100, 100000000u, digit_values, NULL, 100, 9, 4},
+	{MAX_INT / 101, 104060401u, digit_values, NULL, 101, 9, 4},
+	{MAX_INT / 102, 108243216u, digit_values, NULL, 102, 9, 4},
+	{MAX_INT / 103, 112550881u, digit_values, NULL, 103, 9, 4},
+	{MAX_INT / 104, 116985856u, digit_values, NULL, 104, 9, 4},
+	{MAX_INT / 105, 121550625u, digit_values, NULL, 105, 9, 4},
+	{MAX_INT / 106, 126247696u, digit_values, NULL, 106, 9, 4},
+	{MAX_INT / 107, 131079601u, digit_values, NULL, 107, 9, 4},
+	{MAX_INT / 108, 136048896u, digit_values, NULL, 108, 9, 4},
+	{MAX_INT / 109, 141158161u, digit_values, NULL, 109, 9, 4},
+	{MAX_INT / 110, 146410000u, digit_values, NULL, 110, 9, 4},
+	{MAX_INT / 111, 151807041u, digit_values, NULL, 111, 9, 4},
+	{MAX_INT / 112, 157351936u, digit_values, NULL, 112, 9, 4},
+	{MAX_INT / 113, 163047361u, digit_values, NULL, 113, 9, 4},
+	{MAX_INT / 114, 168896016u, digit_values, NULL, 114, 9, 4},
+	{MAX_INT / 115, 174900625u, digit_values, NULL, 115, 9, 4},
+	{MAX_INT / 116, 181063936u, digit_values, NULL, 116, 9, 4},
+	{MAX_INT / 117, 187388721u, digit_values, NULL, 117, 9, 4},
+	{MAX_INT / 118, 193877776u, digit_values, NULL, 118, 9, 4},
+	{MAX_INT / 119, 200533921u, digit_values, NULL, 119, 9, 4},
+	{MAX_INT / 120, 207360000u, digit_values, NULL, 120, 9, 4},
+	{MAX_INT / 121, 214358881u, digit_values, NULL, 121, 9, 4},
+	{MAX_INT / 122, 221533456u, digit_values, NULL, 122, 9, 4},
+	{MAX_INT / 123, 228886641u, digit_values, NULL, 123, 9, 4},
+	{MAX_INT / 124, 236421376u, digit_values, NULL, 124, 9, 4},
+	{MAX_INT / 125, 244140625u, digit_values, NULL, 125, 9, 4},
+	{MAX_INT / 126, 252047376u, digit_values, NULL, 126, 9, 4},
+	{MAX_INT / 127, 260144641u, digit_values, NULL, 127, 9, 4},
+	{MAX_INT / 128, 268435456u, digit_values, NULL, 128, 9, 4},
+	{MAX_INT / 129, 276922881u, digit_values, NULL, 129, 8, 4},
+	{MAX_INT / 130, 285610000u, digit_values, NULL, 130, 8, 4},
+	{MAX_INT / 131, 294499921u, digit_values, NULL, 131, 8, 4},
+	{MAX_INT / 132, 303595776u, digit_values, NULL, 132, 8, 4},
+	{MAX_INT / 133, 312900721u, digit_values, NULL, 133, 8, 4},
+	{MAX_INT / 134, 322417936u, digit_values, NULL, 134, 8, 4},
+	{MAX_INT / 135, 332150625u, digit_values, NULL, 135, 8, 4},
+	{MAX_INT / 136, 342102016u, digit_values, NULL, 136, 8, 4},
+	{MAX_INT / 137, 352275361u, digit_values, NULL, 137, 8, 4},
+	{MAX_INT / 138, 362673936u, digit_values, NULL, 138, 8, 4},
+	{MAX_INT / 139, 373301041u, digit_values, NULL, 139, 8, 4},
+	{MAX_INT / 140, 384160000u, digit_values, NULL, 140, 8, 4},
+	{MAX_INT / 141, 395254161u, digit_values, NULL, 141, 8, 4},
+	{MAX_INT / 142, 406586896u, digit_values, NULL, 142, 8, 4},
+	{MAX_INT / 143, 418161601u, digit_values, NULL, 143, 8, 4},
+	{MAX_INT / 144, 429981696u, digit_values, NULL, 144, 8, 4},
+	{MAX_INT / 145, 442050625u, digit_values, NULL, 145, 8, 4},
+	{MAX_INT / 146, 454371856u, digit_values, NULL, 146, 8, 4},
+	{MAX_INT / 147, 466948881u, digit_values, NULL, 147, 8, 4},
+	{MAX_INT / 148, 479785216u, digit_values, NULL, 148, 8, 4},
+	{MAX_INT / 149, 492884401u, digit_values, NULL, 149, 8, 4},
+	{MAX_INT / 150, 506250000u, digit_values, NULL, 150, 8, 4},
+	{MAX_INT / 151, 519885601u, digit_values, NULL, 151, 8, 4},
+	{MAX_INT / 152, 533794816u, digit_values, NULL, 152, 8, 4},
+	{MAX_INT / 153, 547981281u, digit_values, NULL, 153, 8, 4},
+	{MAX_INT / 154, 562448656u, digit_values, NULL, 154, 8, 4},
+	{MAX_INT / 155, 577200625u, digit_values, NULL, 155, 8, 4},
+	{MAX_INT / 156, 592240896u, digit_values, NULL, 156, 8, 4},
+	{MAX_INT / 157, 607573201u, digit_values, NULL, 157, 8, 4},
+	{MAX_INT / 158, 623201296u, digit_values, NULL, 158, 8, 4},
+	{MAX_INT / 159, 639128961u, digit_values, NULL, 159, 8, 4},
+	{MAX_INT / 160, 655360000u, digit_values, NULL, 160, 8, 4},
+	{MAX_INT / 161, 671898241u, digit_values, NULL, 161, 8, 4},
+	{MAX_INT / 162, 688747536u, digit_values, NULL, 162, 8, 4},
+	{MAX_INT / 163, 705911761u, digit_values, NULL, 163, 8, 4},
+	{MAX_INT / 164, 723394816u, digit_values, NULL, 164, 8, 4},
+	{MAX_INT / 165, 741200625u, digit_values, NULL, 165, 8, 4},
+	{MAX_INT / 166, 759333136u, digit_values, NULL, 166, 8, 4},
+	{MAX_INT / 167, 777796321u, digit_values, NULL, 167, 8, 4},
+	{MAX_INT / 168, 796594176u, digit_values, NULL, 168, 8, 4},
+	{MAX_INT / 169, 815730721u, digit_values, NULL, 169, 8, 4},
+	{MAX_INT / 170, 835210000u, digit_values, NULL, 170, 8, 4},
+	{MAX_INT / 171, 855036081u, digit_values, NULL, 171, 8, 4},
+	{MAX_INT / 172, 875213056u, digit_values, NULL, 172, 8, 4},
+	{MAX_INT / 173, 895745041u, digit_values, NULL, 173, 8, 4},
+	{MAX_INT / 174, 916636176u, digit_values, NULL, 174, 8, 4},
+	{MAX_INT / 175, 937890625u, digit_values, NULL, 175, 8, 4},
+	{MAX_INT / 176, 959512576u, digit_values, NULL, 176, 8, 4},
+	{MAX_INT / 177, 981506241u, digit_values, NULL, 177, 8, 4},
+	{MAX_INT / 178, 1003875856u, digit_values, NULL, 178, 8, 4},
+	{MAX_INT / 179, 1026625681u, digit_values, NULL, 179, 8, 4},
+	{MAX_INT / 180, 1049760000u, digit_values, NULL, 180, 8, 4},
+	{MAX_INT / 181, 1073283121u, digit_values, NULL, 181, 8, 4},
+	{MAX_INT / 182, 1097199376u, digit_values, NULL, 182, 8, 4},
+	{MAX_INT / 183, 1121513121u, digit_values, NULL, 183, 8, 4},
+	{MAX_INT / 184, 1146228736u, digit_values, NULL, 184, 8, 4},
+	{MAX_INT / 185, 1171350625u, digit_values, NULL, 185, 8, 4},
+	{MAX_INT / 186, 1196883216u, digit_values, NULL, 186, 8, 4},
+	{MAX_INT / 187, 1222830961u, digit_values, NULL, 187, 8, 4},
+	{MAX_INT / 188, 1249198336u, digit_values, NULL, 188, 8, 4},
+	{MAX_INT / 189, 1275989841u, digit_values, NULL, 189, 8, 4},
+	{MAX_INT / 190, 1303210000u, digit_values, NULL, 190, 8, 4},
+	{MAX_INT / 191, 1330863361u, digit_values, NULL, 191, 8, 4},
+	{MAX_INT / 192, 1358954496u, digit_values, NULL, 192, 8, 4},
+	{MAX_INT / 193, 1387488001u, digit_values, NULL, 193, 8, 4},
+	{MAX_INT / 194, 1416468496u, digit_values, NULL, 194, 8, 4},
+	{MAX_INT / 195, 1445900625u, digit_values, NULL, 195, 8, 4},
+	{MAX_INT / 196, 1475789056u, digit_values, NULL, 196, 8, 4},
+	{MAX_INT / 197, 1506138481u, digit_values, NULL, 197, 8, 4},
+	{MAX_INT / 198, 1536953616u, digit_values, NULL, 198, 8, 4},
+	{MAX_INT / 199, 1568239201u, digit_values, NULL, 199, 8, 4},
+	{MAX_INT / 200, 1600000000u, digit_values, NULL, 200, 8, 4},
+	{MAX_INT / 201, 1632240801u, digit_values, NULL, 201, 8, 4},
+	{MAX_INT / 202, 1664966416u, digit_values, NULL, 202, 8, 4},
+	{MAX_INT / 203, 1698181681u, digit_values, NULL, 203, 8, 4},
+	{MAX_INT / 204, 1731891456u, digit_values, NULL, 204, 8, 4},
+	{MAX_INT / 205, 1766100625u, digit_values, NULL, 205, 8, 4},
+	{MAX_INT / 206, 1800814096u, digit_values, NULL, 206, 8, 4},
+	{MAX_INT / 207, 1836036801u, digit_values, NULL, 207, 8, 4},
+	{MAX_INT / 208, 1871773696u, digit_values, NULL, 208, 8, 4},
+	{MAX_INT / 209, 1908029761u, digit_values, NULL, 209, 8, 4},
+	{MAX_INT / 210, 1944810000u, digit_values, NULL, 210, 8, 4},
+	{MAX_INT / 211, 1982119441u, digit_values, NULL, 211, 8, 4},
+	{MAX_INT / 212, 2019963136u, digit_values, NULL, 212, 8, 4},
+	{MAX_INT / 213, 2058346161u, digit_values, NULL, 213, 8, 4},
+	{MAX_INT / 214, 2097273616u, digit_values, NULL, 214, 8, 4},
+	{MAX_INT / 215, 2136750625u, digit_values, NULL, 215, 8, 4},
+	{MAX_INT / 216, 2176782336u, digit_values, NULL, 216, 8, 4},
+	{MAX_INT / 217, 2217373921u, digit_values, NULL, 217, 8, 4},
+	{MAX_INT / 218, 2258530576u, digit_values, NULL, 218, 8, 4},
+	{MAX_INT / 219, 2300257521u, digit_values, NULL, 219, 8, 4},
+	{MAX_INT / 220, 2342560000u, digit_values, NULL, 220, 8, 4},
+	{MAX_INT / 221, 2385443281u, digit_values, NULL, 221, 8, 4},
+	{MAX_INT / 222, 2428912656u, digit_values, NULL, 222, 8, 4},
+	{MAX_INT / 223, 2472973441u, digit_values, NULL, 223, 8, 4},
+	{MAX_INT / 224, 2517630976u, digit_values, NULL, 224, 8, 4},
+	{MAX_INT / 225, 2562890625u, digit_values, NULL, 225, 8, 4},
+	{MAX_INT / 226, 2608757776u, digit_values, NULL, 226, 8, 4},
+	{MAX_INT / 227, 2655237841u, digit_values, NULL, 227, 8, 4},
+	{MAX_INT / 228, 2702336256u, digit_values, NULL, 228, 8, 4},
+	{MAX_INT / 229, 2750058481u, digit_values, NULL, 229, 8, 4},
+	{MAX_INT / 230, 2798410000u, digit_values, NULL, 230, 8, 4},
+	{MAX_INT / 231, 2847396321u, digit_values, NULL, 231, 8, 4},
+	{MAX_INT / 232, 2897022976u, digit_values, NULL, 232, 8, 4},
+	{MAX_INT / 233, 2947295521u, digit_values, NULL, 233, 8, 4},
+	{MAX_INT / 234, 2998219536u, digit_values, NULL, 234, 8, 4},
+	{MAX_INT / 235, 3049800625u, digit_values, NULL, 235, 7, 4},
+	{MAX_INT / 236, 3102044416u, digit_values, NULL, 236, 7, 4},
+	{MAX_INT / 237, 3154956561u, digit_values, NULL, 237, 7, 4},
+	{MAX_INT / 238, 3208542736u, digit_values, NULL, 238, 7, 4},
+	{MAX_INT / 239, 3262808641u, digit_values, NULL, 239, 7, 4},
+	{MAX_INT / 240, 3317760000u, digit_values, NULL, 240, 7, 4},
+	{MAX_INT / 241, 3373402561u, digit_values, NULL, 241, 7, 4},
+	{MAX_INT / 242, 3429742096u, digit_values, NULL, 242, 7, 4},
+	{MAX_INT / 243, 3486784401u, digit_values, NULL, 243, 7, 4},
+	{MAX_INT / 244, 3544535296u, digit_values, NULL, 244, 7, 4},
+	{MAX_INT / 245, 3603000625u, digit_values, NULL, 245, 7, 4},
+	{MAX_INT / 246, 3662186256u, digit_values, NULL, 246, 7, 4},
+	{MAX_INT / 247, 3722098081u, digit_values, NULL, 247, 7, 4},
+	{MAX_INT / 248, 3782742016u, digit_values, NULL, 248, 7, 4},
+	{MAX_INT / 249, 3844124001u, digit_values, NULL, 249, 7, 4},
+	{MAX_INT / 250, 3906250000u, digit_values, NULL, 250, 7, 4},
+	{MAX_INT / 251, 3969126001u, digit_values, NULL, 251, 7, 4},
+	{MAX_INT / 252, 4032758016u, digit_values, NULL, 252, 7, 4},
+	{MAX_INT / 253, 4097152081u, digit_values, NULL, 253, 7, 4},
+	{MAX_INT / 254, 4162314256u, digit_values, NULL, 254, 7, 4},
+	{MAX_INT / 255, 4228250625u, digit_values, NULL, 255, 7, 4},
+};
+
+void number_base_init(number_base* desc, uint8_t base, const uint8_t* digits) {
+	*desc = number_bases[base];
+
+	if (digits) {
+		desc->digits = digits;
+	}
+}
@@ -0,0 +1,350 @@
+/*
+ * Copyright (c) 2016 Simon Schoenenberger
+ * https://github.com/detomon/number_parser
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include "number_batch.h"
+#include "number_internal.h"
+#include "number_simd.h"
+
+#define MAX_POS_INT ((uint64_t) INT64_MAX)
+#define MAX_EXACT ((uint64_t) 1 << 53) // largest mantissa exactly representable as double
+#define MAX_EXACT_POW10 22             // largest power of ten exactly representable as double
+#define END_BLOCK 16                   // number of parsers finalized together
+#define SCAN_BLOCK 64                  // number of tokens bucketed together
+#define MAX_INT ((uint64_t) INT64_MAX + 1)
+
+static const double exact_pows_10[MAX_EXACT_POW10 + 1] = {
+	1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+	1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+};
+
+/**
+ * Initialize `parser` with the decimal integer `value` of the `len` digits at
+ * `str` in the state left by number_parser_scan(). Leading zeros are skipped
+ * and trailing zeros are counted in `zero_len`.
+ */
+static void set_int(number_parser* parser, const number_base* desc, uint64_t value, const char* str, int len, int sign) {
+	int zeros = 0;
+
+	number_parser_init_base(parser, desc);
+
+	if (value) {
+		while (*str == '0') {
+			str ++;
+			len --;
+		}
+
+		while (value % 10 == 0) {
+			value /= 10;
+			zeros ++;
+		}
+	}
+	else {
+		zeros = len;
+	}
+
+	parser->uval = value;
+	parser->int_len = len - zeros;
+	parser->zero_len = zeros;
+	parser->sign = sign;
+}
+
+size_t number_parser_scan_batch(number_parser* parsers, size_t count, const number_base* desc, const char** str, const char* end, char delim, int flags) {
+	const char* s = *str;
+	size_t n = 0;
+
+	while (n < count && s < end) {
+		number_parser* parser = &parsers[n];
+		const char* e;
+
+#ifdef NUMBER_SIMD_TOKENS
+		// convert 4 short integers at once; integers are not accepted if an
+		// exponent is required
+		if (desc->base == 10 && desc->digits == number_digit_values && !(flags & NUMBER_PARSER_SCAN_EXP_REQUIRED) && count - n >= 4 && end - s >= 16) {
+			uint32_t values[4];
+			uint8_t lens[4];
+			int used;
+			int tokens = number_simd_tokens16(s, delim, values, lens, &used);
+
+			e = s;
+
+			for (int i = 0; i < tokens; i ++) {
+				set_int(&parser[i], desc, values[i], e, lens[i], 0);
+				e += lens[i] + 1;
+			}
+
+			if (tokens) {
+				n += tokens;
+				s += used;
+				continue;
+			}
+		}
+#endif
+
+		number_parser_init_base(parser, desc);
+		e = number_parser_scan(parser, s, end, flags);
+
+		if (e == s || (e < end && *e != delim)) {
+			break;
+		}
+
+		n ++;
+		s = e < end ? e + 1 : e;
+	}
+
+	*str = s;
+
+	return n;
+}
+
+/**
+ * Token buckets of number_parser_scan_tokens().
+ */
+enum {
+	BUCKET_INT8,    // up to 8 digits
+	BUCKET_INT16,   // 9 to 16 digits
+	BUCKET_INT19,   // 17 to 19 digits, which may overflow
+	BUCKET_GENERIC, // fractions, exponents, long integers and invalid tokens
+	BUCKET_COUNT,
+};
+
+/**
+ * Load the `len` characters at `str`, where `len` is between 0 and 8,
+ * right-aligned in a block of 8 characters padded with `0`. The first
+ * character is in the lowest byte.
+ */
+static uint64_t load8(const char* str, size_t len) {
+	unsigned char buf[8];
+	uint64_t chunk = 0;
+
+	memset(buf, '0', sizeof(buf));
+	memcpy(&buf[8 - len], str, len);
+
+	for (int i = 0; i < 8; i ++) {
+		chunk |= (uint64_t) buf[i] << (i * 8);
+	}
+
+	return chunk;
+}
+
+/**
+ * Returns a value with the high bit of each byte of `chunk` set which is not
+ * a decimal digit. Bytes after a non-digit may also be marked.
+ */
+static uint64_t non_digits8(uint64_t chunk) {
+	return ((chunk - 0x3030303030303030) | (chunk + 0x4646464646464646)) & 0x8080808080808080;
+}
+
+/**
+ * Convert the 8 decimal digits in `chunk` with 3 multiplications.
+ */
+static uint64_t digits8(uint64_t chunk) {
+	uint64_t val = chunk - 0x3030303030303030;
+
+	val = (val * 10 + (val >> 8)) & 0x00FF00FF00FF00FF;
+	val = (val * 100 + (val >> 16)) & 0x0000FFFF0000FFFF;
+	val = (val * 10000 + (val >> 32)) & 0xFFFFFFFF;
+
+	return val;
+}
+
+/**
+ * Scan `str` with the generic parser. Returns 0 if the string is not entirely
+ * a number matching `flags`.
+ */
+static int scan_token(number_parser* parser, const number_base* desc, const char* str, size_t len, int flags) {
+	number_parser_init_base(parser, desc);
+
+	return len && number_parser_scan(parser, str, str + len, flags) == str + len;
+}
+
+size_t number_parser_scan_tokens(number_parser* parsers, const char* const* strs, const size_t* lens, size_t count, const number_base* desc, int flags) {
+	static const uint8_t len_buckets[20] = {
+		BUCKET_GENERIC,
+		BUCKET_INT8, BUCKET_INT8, BUCKET_INT8, BUCKET_INT8,
+		BUCKET_INT8, BUCKET_INT8, BUCKET_INT8, BUCKET_INT8,
+		BUCKET_INT16, BUCKET_INT16, BUCKET_INT16, BUCKET_INT16,
+		BUCKET_INT16, BUCKET_INT16, BUCKET_INT16, BUCKET_INT16,
+		BUCKET_INT19, BUCKET_INT19, BUCKET_INT19,
+	};
+	size_t error = count;
+	// integers are not accepted if an exponent is required
+	int fast = desc->base == 10 && desc->digits == number_digit_values && !(flags & NUMBER_PARSER_SCAN_EXP_REQUIRED);
+
+	for (size_t i = 0; i < count; i += SCAN_BLOCK) {
+		size_t len = count - i < SCAN_BLOCK ? count - i : SCAN_BLOCK;
+		uint8_t buckets[BUCKET_COUNT][SCAN_BLOCK];
+		uint8_t signs[SCAN_BLOCK];
+		size_t sizes[BUCKET_COUNT] = {0};
+
+		// sort tokens into buckets by length; the digits are checked by the
+		// integer kernels, which pass invalid tokens on to the generic bucket
+		for (size_t j = 0; j < len; j ++) {
+			const char* str = strs[i + j];
+			size_t size = lens[i + j];
+			int sign = (flags & NUMBER_PARSER_SCAN_SIGN) && size && str[0] == '-';
+			size_t digits = size - sign;
+			int bucket = fast && digits < 20 ? len_buckets[digits] : BUCKET_GENERIC;
+
+			signs[j] = sign;
+			buckets[bucket][sizes[bucket] ++] = j;
+		}
+
+		for (size_t k = 0; k < sizes[BUCKET_INT8]; k ++) {
+			size_t j = buckets[BUCKET_INT8][k];
+			size_t digits = lens[i + j] - signs[j];
+			uint64_t chunk = load8(strs[i + j] + signs[j], digits);
+
+			if (non_digits8(chunk)) {
+				buckets[BUCKET_GENERIC][sizes[BUCKET_GENERIC] ++] = j;
+				continue;
+			}
+
+			set_int(&parsers[i + j], desc, digits8(chunk), strs[i + j] + signs[j], digits, signs[j]);
+		}
+
+		for (size_t k = 0; k < sizes[BUCKET_INT16]; k ++) {
+			size_t j = buckets[BUCKET_INT16][k];
+			const char* str = strs[i + j] + signs[j];
+			size_t digits = lens[i + j] - signs[j];
+			uint64_t hi = load8(str, digits - 8);
+			uint64_t lo = load8(str + digits - 8, 8);
+
+			if (non_digits8(hi) | non_digits8(lo)) {
+				buckets[BUCKET_GENERIC][sizes[BUCKET_GENERIC] ++] = j;
+				continue;
+			}
+
+			set_int(&parsers[i + j], desc, digits8(hi) * 100000000 + digits8(lo), str, digits, signs[j]);
+		}
+
+		for (size_t k = 0; k < sizes[BUCKET_INT19]; k ++) {
+			size_t j = buckets[BUCKET_INT19][k];
+			const char* str = strs[i + j] + signs[j];
+			size_t digits = lens[i + j] - signs[j];
+			uint64_t hi = load8(str, digits - 16);
+			uint64_t mid = load8(str + digits - 16, 8);
+			uint64_t lo = load8(str + digits - 8, 8);
+			uint64_t value = digits8(hi) * 10000000000000000 + digits8(mid) * 100000000 + digits8(lo);
+
+			// values greater than `MAX_INT` are converted to float by the parser
+			if ((non_digits8(hi) | non_digits8(mid) | non_digits8(lo)) || value > MAX_INT) {
+				buckets[BUCKET_GENERIC][sizes[BUCKET_GENERIC] ++] = j;
+				continue;
+			}
+
+			set_int(&parsers[i + j], desc, value, str, digits, signs[j]);
+		}
+
+		for (size_t k = 0; k < sizes[BUCKET_GENERIC]; k ++) {
+			size_t j = buckets[BUCKET_GENERIC][k];
+
+			if (!scan_token(&parsers[i + j], desc, strs[i + j], lens[i + j], flags) && i + j < error) {
+				error = i + j;
+			}
+		}
+	}
+
+	return error;
+}
+
+size_t number_parser_end_batch(number_parser* parsers, size_t count) {
+	size_t floats = 0;
+
+	for (size_t i = 0; i < count; i += END_BLOCK) {
+		size_t len = count - i < END_BLOCK ? count - i : END_BLOCK;
+		double mant[END_BLOCK], mul[END_BLOCK], div[END_BLOCK];
+		uint8_t idx[END_BLOCK];
+		size_t exact = 0;
+
+		for (size_t j = 0; j < len; j ++) {
+			number_parser* parser = &parsers[i + j];
+			uint64_t sign = parser->sign;
+			uint64_t value = parser->uval;
+			int is_int = !parser->is_float && !parser->has_exp && parser->rad_off < 0;
+			int n;
+
+			// trailing zeros of decimal integers are added if the integer
+			// does not overflow like in number_parser_end()
+			if (is_int && parser->zero_len) {
+				is_int = parser->base == 10 && parser->zero_len < 20 && !number_mul_add_overflow(value, number_int_pows_10[parser->zero_len], 0, MAX_INT, &value);
+			}
+
+			if (is_int && (sign || value <= MAX_POS_INT)) {
+				// negate without branching; wraps for the minimum integer
+				parser->uval = (value ^ -sign) + sign;
+				continue;
+			}
+
+			n = parser->exp_sign ? -parser->exp_val : parser->exp_val;
+
+			if (parser->rad_off >= 0) {
+				n -= parser->int_len - parser->rad_off;
+			}
+			else {
+				n += parser->zero_len;
+			}
+
+			// both the mantissa and the power of ten are exact, so a single
+			// multiplication or division is correctly rounded; integers which
+			// overflow are left to number_parser_end()
+			if (!parser->is_float && (parser->has_exp || parser->rad_off >= 0) && parser->base == 10 && parser->uval <= MAX_EXACT && n >= -MAX_EXACT_POW10 && n <= MAX_EXACT_POW10) {
+				mant[exact] = (double) parser->uval;
+				mant[exact] = sign ? -mant[exact] : mant[exact];
+				mul[exact] = exact_pows_10[n > 0 ? n : 0];
+				div[exact] = exact_pows_10[n < 0 ? -n : 0];
+				idx[exact ++] = j;
+			}
+			else {
+				floats += number_parser_end(parser);
+			}
+		}
+
+		// multiplying or dividing by 1 is exact
+		for (size_t k = 0; k < exact; k ++) {
+			mant[k] = mant[k] * mul[k] / div[k];
+		}
+
+		for (size_t k = 0; k < exact; k ++) {
+			number_parser* parser = &parsers[i + idx[k]];
+
+			parser->is_float = 1;
+			parser->fval = mant[k];
+		}
+
+		floats += exact;
+	}
+
+	return floats;
+}
+
+void number_parser_end_half_batch(number_parser* parsers, size_t count, uint16_t* values) {
+	for (size_t i = 0; i < count; i ++) {
+		values[i] = number_parser_end_half(&parsers[i]);
+	}
+}
+
+void number_parser_end_bfloat16_batch(number_parser* parsers, size_t count, uint16_t* values) {
+	for (size_t i = 0; i < count; i ++) {
+		values[i] = number_parser_end_bfloat16(&parsers[i]);
+	}
+}
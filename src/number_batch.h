@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2016 Simon Schoenenberger
+ * https://github.com/detomon/number_parser
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+/**
+ * @file
+ *
+ * Batch parsing of many numbers with the number parser.
+ *
+ * number_parser_scan_batch() scans a list of numbers separated by a
+ * delimiter into an array of number parsers, which can then be terminated
+ * together with number_parser_end_batch(). number_parser_scan_tokens() scans
+ * an array of separate strings.
+ *
+ * @code{.c}
+ * const char* str = "1,22,3,456,7";
+ * number_parser parsers[16];
+ *
+ * size_t count = number_parser_scan_batch(parsers, 16, &number_bases[10],
+ *     &str, str + strlen(str), ',', NUMBER_PARSER_SCAN_SIGN);
+ *
+ * number_parser_end_batch(parsers, count);
+ * @endcode
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include "number_parser.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Scan the numbers separated by `delim` in the string from `str` to `end` into
+ * `parsers`.
+ *
+ * Each parser is initialized with `desc` and fed like number_parser_scan()
+ * with `flags`, but is not terminated. A number has to be followed by `delim`
+ * or the end of the string. Short decimal integers are converted several at
+ * once if supported by the target. The parser states are identical to those
+ * of number_parser_scan().
+ *
+ * @param parsers The array of parsers to fill.
+ * @param count The number of parsers in `parsers`.
+ * @param desc The base descriptor used to initialize the parsers.
+ * @param str The start of the string. Is set to the first character not
+ * consumed.
+ * @param end The end of the string.
+ * @param delim The delimiter, which must not be a digit in the parser's base.
+ * @param flags The accepted parts of the numbers.
+ * @return The number of scanned numbers. Scanning stops early if `parsers` is
+ * full or a token is not a number matching `flags`.
+ */
+extern size_t number_parser_scan_batch(number_parser* parsers, size_t count, const number_base* desc, const char** str, const char* end, char delim, int flags);
+
+/**
+ * Scan the `count` strings `strs` with the lengths `lens` into `parsers`.
+ *
+ * Each parser is initialized with `desc` and fed like number_parser_scan()
+ * with `flags`, but is not terminated. For decimal numbers, the strings are
+ * first grouped by their length and shape, so short integers are converted by
+ * kernels specialized on their length. The parser states are identical to
+ * those of number_parser_scan().
+ *
+ * @param parsers The array of `count` parsers to fill.
+ * @param strs The strings to scan.
+ * @param lens The lengths of the strings.
+ * @param count The number of strings.
+ * @param desc The base descriptor used to initialize the parsers.
+ * @param flags The accepted parts of the numbers.
+ * @return The index of the first string which is not entirely a number
+ * matching `flags` or `count` if all strings are numbers. All strings are
+ * scanned in any case.
+ */
+extern size_t number_parser_scan_tokens(number_parser* parsers, const char* const* strs, const size_t* lens, size_t count, const number_base* desc, int flags);
+
+/**
+ * Terminate the `count` parsers in `parsers` like number_parser_end().
+ *
+ * Each parser is classified by its state. Integers are negated in place, and
+ * decimal numbers with a mantissa of at most 53 bits and a decimal exponent
+ * between -22 and 22 are collected and scaled together in a loop without
+ * branches. Other numbers are terminated with number_parser_end(). The
+ * results are identical in all cases.
+ *
+ * @param parsers The array of parsers to terminate.
+ * @param count The number of parsers in `parsers`.
+ * @return The number of floating-point values.
+ */
+extern size_t number_parser_end_batch(number_parser* parsers, size_t count);
+
+/**
+ * Terminate the `count` parsers in `parsers` with number_parser_end_half()
+ * and store the binary16 values in `values`.
+ *
+ * @param parsers The array of parsers to terminate.
+ * @param count The number of parsers in `parsers`.
+ * @param values The array of `count` values.
+ */
+extern void number_parser_end_half_batch(number_parser* parsers, size_t count, uint16_t* values);
+
+/**
+ * Terminate the `count` parsers in `parsers` with
+ * number_parser_end_bfloat16() and store the bfloat16 values in `values`.
+ *
+ * @param parsers The array of parsers to terminate.
+ * @param count The number of parsers in `parsers`.
+ * @param values The array of `count` values.
+ */
+extern void number_parser_end_bfloat16_batch(number_parser* parsers, size_t count, uint16_t* values);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,600 @@
+/*
+ * Copyright (c) 2016 Simon Schoenenberger
+ * https://github.com/detomon/number_parser
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include "number_bigint.h"
+#include "number_internal.h"
+
+#define DC_MIN_DIGITS 6000  // inputs with more digits are converted by divide and conquer
+#define DC_BASE_DIGITS 600  // maximum number of digits converted by chunks when dividing
+#define KARATSUBA_MIN 32    // operands with fewer limbs are multiplied directly
+#define NTT_MIN 8192        // operands with at least as many limbs are multiplied by transform
+#define NTT_P 0xFFFFFFFF00000001 // prime 2 ^ 64 - 2 ^ 32 + 1 with roots of unity of order 2 ^ 32
+#define NTT_G 7             // generator of the multiplicative group modulo `NTT_P`
+
+/**
+ * Calculate `big` * `mul` + `add`. Returns 0 if the result does not fit.
+ */
+static int bigint_mul_add(number_bigint* big, uint64_t mul, uint64_t add) {
+	uint64_t carry = add;
+
+	for (size_t i = 0; i < big->len; i ++) {
+		uint64_t lo;
+		uint64_t hi = number_mul128(big->limbs[i], mul, &lo);
+
+		lo += carry;
+		carry = hi + (lo < carry);
+		big->limbs[i] = lo;
+	}
+
+	if (carry) {
+		if (big->len >= big->cap) {
+			return 0;
+		}
+
+		big->limbs[big->len ++] = carry;
+	}
+
+	return 1;
+}
+
+/**
+ * Store the digits from `str` to `end` of a power-of-two base with `bits` bits
+ * per digit, starting with the least significant one.
+ */
+static int bigint_set_pow2(number_bigint* big, const uint8_t* digits, const char* str, const char* end, int bits) {
+	uint64_t limb = 0;
+	int pos = 0;
+
+	big->len = 0;
+
+	while (end > str) {
+		uint64_t digit = digits[(uint8_t) *-- end];
+
+		limb |= digit << pos;
+		pos += bits;
+
+		if (pos >= 64) {
+			if (big->len >= big->cap) {
+				return 0;
+			}
+
+			big->limbs[big->len ++] = limb;
+			pos -= 64;
+			limb = pos ? digit >> (bits - pos) : 0;
+		}
+	}
+
+	if (limb) {
+		if (big->len >= big->cap) {
+			return 0;
+		}
+
+		big->limbs[big->len ++] = limb;
+	}
+
+	// the leading digit may not fill the last limb
+	while (big->len && !big->limbs[big->len - 1]) {
+		big->len --;
+	}
+
+	return 1;
+}
+
+/**
+ * Accumulate the digits from `str` to `end` in chunks of `safe_len` digits.
+ */
+static int bigint_set_chunked(number_bigint* big, const number_base* desc, const char* str, const char* end) {
+	const uint8_t* digits = desc->digits;
+	int base = desc->base;
+	int len = desc->safe_len;
+
+	big->len = 0;
+
+	while (str < end) {
+		uint64_t chunk = 0;
+		uint64_t mul = 1;
+
+		// the chunk and `mul` never overflow with at most `safe_len` digits
+		for (const char* e = end - str > len ? str + len : end; str < e; str ++) {
+			chunk = chunk * base + digits[(uint8_t) *str];
+			mul *= base;
+		}
+
+		if (!bigint_mul_add(big, mul, chunk)) {
+			return 0;
+		}
+	}
+
+	return 1;
+}
+
+/**
+ * Add `b` with `bn` limbs to `a` with `an` >= `bn` limbs. Returns the carry.
+ */
+static uint64_t limbs_add(uint64_t* a, size_t an, const uint64_t* b, size_t bn) {
+	uint64_t carry = 0;
+	size_t i;
+
+	for (i = 0; i < bn; i ++) {
+		uint64_t t = a[i] + carry;
+
+		carry = t < carry;
+		a[i] = t + b[i];
+		carry += a[i] < t;
+	}
+
+	for (; carry && i < an; i ++) {
+		carry = ++ a[i] == 0;
+	}
+
+	return carry;
+}
+
+/**
+ * Subtract `b` with `bn` limbs from `a` with `an` >= `bn` limbs. The result
+ * must not be negative.
+ */
+static void limbs_sub(uint64_t* a, size_t an, const uint64_t* b, size_t bn) {
+	uint64_t borrow = 0;
+	size_t i;
+
+	for (i = 0; i < bn; i ++) {
+		uint64_t t = a[i] - borrow;
+
+		borrow = a[i] < borrow;
+		borrow += t < b[i];
+		a[i] = t - b[i];
+	}
+
+	for (; borrow && i < an; i ++) {
+		borrow = a[i] -- == 0;
+	}
+}
+
+/**
+ * Get the number of limbs of `a` without leading zero limbs.
+ */
+static size_t limbs_trim(const uint64_t* a, size_t n) {
+	while (n && !a[n - 1]) {
+		n --;
+	}
+
+	return n;
+}
+
+/**
+ * Calculate `a` * `b` into `r` with `an` + `bn` limbs using the schoolbook
+ * method.
+ */
+static void limbs_mul_basic(uint64_t* r, const uint64_t* a, size_t an, const uint64_t* b, size_t bn) {
+	memset(r, 0, an * sizeof(*r));
+
+	for (size_t i = 0; i < bn; i ++) {
+		uint64_t carry = 0;
+
+		for (size_t j = 0; j < an; j ++) {
+			uint64_t lo;
+			uint64_t hi = number_mul128(a[j], b[i], &lo);
+
+			lo += carry;
+			hi += lo < carry;
+			lo += r[i + j];
+			hi += lo < r[i + j];
+			r[i + j] = lo;
+			carry = hi;
+		}
+
+		r[i + an] = carry;
+	}
+}
+
+/**
+ * Calculate `a` * `b` modulo `NTT_P`.
+ */
+static uint64_t ntt_mul(uint64_t a, uint64_t b) {
+	uint64_t lo;
+	uint64_t hi = number_mul128(a, b, &lo);
+	uint64_t hh = hi >> 32;
+	uint64_t hl = (uint32_t) hi;
+	uint64_t t, r;
+
+	// 2 ^ 64 = 2 ^ 32 - 1 and 2 ^ 96 = -1 modulo `NTT_P`; the corrections are
+	// branchless as they depend on random data
+	t = lo - hh;
+	t -= 0xFFFFFFFF & -(uint64_t) (lo < hh);
+	r = t + hl * 0xFFFFFFFF;
+	r += 0xFFFFFFFF & -(uint64_t) (r < t);
+
+	return r - (NTT_P & -(uint64_t) (r >= NTT_P));
+}
+
+static uint64_t ntt_add(uint64_t a, uint64_t b) {
+	uint64_t r = a + b;
+
+	return r - (NTT_P & -(uint64_t) ((r < a) | (r >= NTT_P)));
+}
+
+static uint64_t ntt_sub(uint64_t a, uint64_t b) {
+	return a - b + (NTT_P & -(uint64_t) (a < b));
+}
+
+static uint64_t ntt_pow(uint64_t a, uint64_t n) {
+	uint64_t r = 1;
+
+	for (; n; n >>= 1) {
+		if (n & 1) {
+			r = ntt_mul(r, a);
+		}
+
+		a = ntt_mul(a, a);
+	}
+
+	return r;
+}
+
+/**
+ * Transform `a` with `n` values in place. The result is in bit-reversed order.
+ * `roots` contains w ^ (j * `n` / (2 * len)) at index len + j for each
+ * butterfly distance len, where w is a primitive `n`-th root of unity.
+ */
+static void ntt_forward(uint64_t* a, size_t n, const uint64_t* roots) {
+	for (size_t len = n / 2; len; len >>= 1) {
+		for (size_t i = 0; i < n; i += 2 * len) {
+			for (size_t j = 0; j < len; j ++) {
+				uint64_t u = a[i + j];
+				uint64_t v = a[i + j + len];
+
+				a[i + j] = ntt_add(u, v);
+				a[i + j + len] = ntt_mul(ntt_sub(u, v), roots[len + j]);
+			}
+		}
+	}
+}
+
+/**
+ * Invert ntt_forward() except for the division by `n`.
+ */
+static void ntt_inverse(uint64_t* a, size_t n, const uint64_t* roots) {
+	for (size_t len = 1; len < n; len <<= 1) {
+		for (size_t i = 0; i < n; i += 2 * len) {
+			for (size_t j = 0; j < len; j ++) {
+				// the inverse root w ^ -k is -w ^ (n / 2 - k)
+				uint64_t w = j ? NTT_P - roots[2 * len - j] : 1;
+				uint64_t u = a[i + j];
+				uint64_t v = ntt_mul(a[i + j + len], w);
+
+				a[i + j] = ntt_add(u, v);
+				a[i + j + len] = ntt_sub(u, v);
+			}
+		}
+	}
+}
+
+/**
+ * Split the limbs of `a` into 16-bit values of `f` padded to `n` values.
+ */
+static void ntt_load(uint64_t* f, size_t n, const uint64_t* a, size_t an) {
+	size_t i;
+
+	for (i = 0; i < an * 4; i ++) {
+		f[i] = (a[i / 4] >> (i % 4 * 16)) & 0xFFFF;
+	}
+
+	memset(f + i, 0, (n - i) * sizeof(*f));
+}
+
+/**
+ * Calculate `a` * `b` into `r` with `an` + `bn` limbs by convolving the 16-bit
+ * parts of the operands with a number-theoretic transform. The convolution is
+ * exact as the sums of at most 2 ^ 31 products of 16-bit parts are less than
+ * `NTT_P`. Returns 0 if the temporary memory cannot be allocated.
+ */
+static int limbs_mul_ntt(uint64_t* r, const uint64_t* a, size_t an, const uint64_t* b, size_t bn) {
+	size_t n = 2;
+	size_t rn = an + bn;
+
+	while (n < rn * 4) {
+		n *= 2;
+	}
+
+	uint64_t* fa = malloc(n * 3 * sizeof(*fa));
+	uint64_t* fb = fa + n;
+	uint64_t* roots = fb + n;
+	uint64_t w, scale, carry = 0;
+
+	if (!fa) {
+		return 0;
+	}
+
+	// the roots of each butterfly distance are stored contiguously
+	w = ntt_pow(NTT_G, (NTT_P - 1) / n);
+	roots[n / 2] = 1;
+
+	for (size_t j = 1; j < n / 2; j ++) {
+		roots[n / 2 + j] = ntt_mul(roots[n / 2 + j - 1], w);
+	}
+
+	for (size_t len = n / 4; len; len >>= 1) {
+		for (size_t j = 0; j < len; j ++) {
+			roots[len + j] = roots[2 * len + 2 * j];
+		}
+	}
+
+	ntt_load(fa, n, a, an);
+	ntt_forward(fa, n, roots);
+
+	// squaring needs only one transform
+	if (a != b || an != bn) {
+		ntt_load(fb, n, b, bn);
+		ntt_forward(fb, n, roots);
+	}
+	else {
+		fb = fa;
+	}
+
+	for (size_t i = 0; i < n; i ++) {
+		fa[i] = ntt_mul(fa[i], fb[i]);
+	}
+
+	ntt_inverse(fa, n, roots);
+	scale = ntt_pow(n, NTT_P - 2);
+
+	for (size_t i = 0; i < rn; i ++) {
+		uint64_t limb = 0;
+
+		for (int k = 0; k < 4; k ++) {
+			carry += ntt_mul(fa[i * 4 + k], scale);
+			limb |= (carry & 0xFFFF) << (k * 16);
+			carry >>= 16;
+		}
+
+		r[i] = limb;
+	}
+
+	free(fa);
+
+	return 1;
+}
+
+/**
+ * Calculate `a` * `b` into `r` with `an` + `bn` limbs. `an` must not be less
+ * than `bn`. `tmp` needs space for 4 * `an` + 16 * log2(`an`) limbs.
+ */
+static void limbs_mul(uint64_t* r, const uint64_t* a, size_t an, const uint64_t* b, size_t bn, uint64_t* tmp) {
+	size_t h = (an + 1) / 2;
+
+	if (bn < KARATSUBA_MIN) {
+		limbs_mul_basic(r, a, an, b, bn);
+		return;
+	}
+
+	if (bn >= NTT_MIN && limbs_mul_ntt(r, a, an, b, bn)) {
+		return;
+	}
+
+	// multiply slices of `a` with the length of `b`
+	if (bn <= h) {
+		memset(r, 0, (an + bn) * sizeof(*r));
+
+		for (size_t i = 0; i < an; i += bn) {
+			size_t n = an - i < bn ? an - i : bn;
+
+			if (n >= bn) {
+				limbs_mul(tmp, a + i, n, b, bn, tmp + n + bn);
+			}
+			else {
+				limbs_mul(tmp, b, bn, a + i, n, tmp + n + bn);
+			}
+
+			limbs_add(r + i, an + bn - i, tmp, n + bn);
+		}
+
+		return;
+	}
+
+	// Karatsuba: (a1 * B + a0) * (b1 * B + b0) with B = 2 ^ (64 * h)
+	uint64_t* sa = tmp;
+	uint64_t* sb = tmp + h + 1;
+	uint64_t* z1 = tmp + 2 * h + 2;
+	size_t n1;
+
+	limbs_mul(r, a, h, b, h, z1);
+	limbs_mul(r + 2 * h, a + h, an - h, b + h, bn - h, z1);
+
+	memcpy(sa, a, h * sizeof(*sa));
+	sa[h] = limbs_add(sa, h, a + h, an - h);
+	memcpy(sb, b, h * sizeof(*sb));
+	sb[h] = limbs_add(sb, h, b + h, bn - h);
+
+	limbs_mul(z1, sa, h + 1, sb, h + 1, z1 + 2 * h + 2);
+	n1 = limbs_trim(z1, 2 * h + 2);
+	limbs_sub(z1, n1, r, 2 * h);
+	limbs_sub(z1, n1, r + 2 * h, an + bn - 2 * h);
+	limbs_add(r + h, an + bn - h, z1, limbs_trim(z1, n1));
+}
+
+/**
+ * State of the divide-and-conquer conversion.
+ */
+typedef struct {
+	const number_base* desc; ///< Base descriptor.
+	uint64_t* pows[64];      ///< `base` ^ `pow_digits[i]`.
+	size_t pow_lens[64];     ///< Number of limbs of `pows`.
+	size_t pow_digits[64];   ///< `safe_len` * 2 ^ i.
+} dc_state;
+
+/**
+ * Convert the digits from `str` to `end` into `out` by splitting off the lower
+ * `safe_len` * 2 ^ i digits and combining the converted halves with the
+ * power `base` ^ (`safe_len` * 2 ^ i). Returns the number of limbs.
+ */
+static size_t dc_convert(const dc_state* dc, const char* str, const char* end, uint64_t* out, uint64_t* tmp) {
+	size_t n = end - str;
+	size_t lo_len, hi_len, pow_len;
+	int i = 0;
+
+	if (n <= DC_BASE_DIGITS) {
+		number_bigint big;
+
+		number_bigint_init(&big, out, number_bigint_limbs(n, dc->desc->base));
+		bigint_set_chunked(&big, dc->desc, str, end);
+
+		return big.len;
+	}
+
+	// the largest split with the lower part longer than the upper part
+	while (dc->pow_digits[i + 1] < n) {
+		i ++;
+	}
+
+	lo_len = dc_convert(dc, end - dc->pow_digits[i], end, out, tmp);
+	hi_len = dc_convert(dc, str, end - dc->pow_digits[i], tmp, tmp + number_bigint_limbs(n, dc->desc->base));
+	pow_len = dc->pow_lens[i];
+
+	if (!hi_len) {
+		return lo_len;
+	}
+
+	uint64_t* prod = tmp + hi_len;
+	size_t len = hi_len + pow_len;
+
+	if (hi_len >= pow_len) {
+		limbs_mul(prod, tmp, hi_len, dc->pows[i], pow_len, prod + len);
+	}
+	else {
+		limbs_mul(prod, dc->pows[i], pow_len, tmp, hi_len, prod + len);
+	}
+
+	limbs_add(prod, len, out, lo_len);
+	memcpy(out, prod, len * sizeof(*out));
+
+	return limbs_trim(out, len);
+}
+
+/**
+ * Convert the digits from `str` to `end` into `big` with dc_convert().
+ * Returns -1 if the temporary memory cannot be allocated.
+ */
+static int bigint_set_dc(number_bigint* big, const number_base* desc, const char* str, const char* end) {
+	dc_state dc = {.desc = desc};
+	size_t n = end - str;
+	size_t limbs = number_bigint_limbs(n, desc->base) + 2;
+	uint64_t* mem = malloc((11 * limbs + 4096) * sizeof(*mem));
+	uint64_t* out = mem;
+	uint64_t* pow = out + limbs;
+	uint64_t* tmp = pow + 2 * limbs + 128;
+	size_t len;
+	int i;
+
+	if (!mem) {
+		return -1;
+	}
+
+	pow[0] = 1;
+
+	for (i = 0; i < desc->safe_len; i ++) {
+		pow[0] *= desc->base;
+	}
+
+	dc.pows[0] = pow;
+	dc.pow_lens[0] = 1;
+	dc.pow_digits[0] = desc->safe_len;
+
+	// square the powers as long as they have fewer digits than the input
+	for (i = 0; dc.pow_digits[i] < n; i ++) {
+		size_t plen = dc.pow_lens[i];
+
+		dc.pow_digits[i + 1] = dc.pow_digits[i] * 2;
+		dc.pows[i + 1] = dc.pows[i] + plen;
+
+		if (dc.pow_digits[i + 1] < n) {
+			limbs_mul(dc.pows[i + 1], dc.pows[i], plen, dc.pows[i], plen, tmp);
+			dc.pow_lens[i + 1] = limbs_trim(dc.pows[i + 1], 2 * plen);
+		}
+	}
+
+	len = dc_convert(&dc, str, end, out, tmp);
+
+	if (len <= big->cap) {
+		memcpy(big->limbs, out, len * sizeof(*out));
+		big->len = len;
+	}
+
+	free(mem);
+
+	return len <= big->cap;
+}
+int number_bigint_scan(number_bigint* big, const number_base* desc, const char** str, const char* end, int flags) {
+	const uint8_t* digits = desc->digits;
+	int base = desc->base;
+	const char* s = *str;
+	const char* start;
+
+	big->len = 0;
+	big->sign = 0;
+
+	if ((flags & NUMBER_PARSER_SCAN_SIGN) && s < end && *s == '-') {
+		big->sign = 1;
+		s ++;
+	}
+
+	for (start = s; s < end && digits[(uint8_t) *s] < base; s ++) {
+		;
+	}
+
+	if (s == start) {
+		return NUMBER_PARSER_ERR_INVALID;
+	}
+
+	// leading zeros do not change the value
+	while (start < s && digits[(uint8_t) *start] == 0) {
+		start ++;
+	}
+
+	if ((base & (base - 1)) == 0) {
+		if (!bigint_set_pow2(big, digits, start, s, number_ctz64(base))) {
+			return NUMBER_PARSER_ERR_RANGE;
+		}
+	}
+	else {
+		int ok = -1;
+
+		// the chunked conversion is quadratic in the number of digits
+		if (s - start > DC_MIN_DIGITS) {
+			ok = bigint_set_dc(big, desc, start, s);
+		}
+
+		if (ok < 0) {
+			ok = bigint_set_chunked(big, desc, start, s);
+		}
+
+		if (!ok) {
+			return NUMBER_PARSER_ERR_RANGE;
+		}
+	}
+
+	*str = s;
+
+	return NUMBER_PARSER_OK;
+}
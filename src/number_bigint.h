@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2016 Simon Schoenenberger
+ * https://github.com/detomon/number_parser
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+/**
+ * @file
+ *
+ * Exact parsing of integers of any length.
+ *
+ * The value is accumulated into an array of 64-bit limbs provided by the
+ * caller. number_bigint_limbs() returns a buffer size which is large enough
+ * for a given number of digits.
+ *
+ * @code{.c}
+ * const char* str = "123456789012345678901234567890";
+ * uint64_t limbs[number_bigint_limbs(30, 10)];
+ * number_bigint big;
+ *
+ * number_bigint_init(&big, limbs, sizeof(limbs) / sizeof(*limbs));
+ *
+ * if (number_bigint_scan(&big, &number_bases[10], &str, str + strlen(str), 0) == NUMBER_PARSER_OK) {
+ *     // big.limbs[0] == 0xc373e0ee4e3f0ad2, big.limbs[1] == 0x18ee90ff6
+ * }
+ * @endcode
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include "number_parser.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * An integer of arbitrary size stored in a caller-provided buffer.
+ */
+typedef struct {
+	uint64_t* limbs; ///< Limbs with the least significant first.
+	size_t len;      ///< Number of used limbs; 0 if the value is 0.
+	size_t cap;      ///< Number of available limbs.
+	uint8_t sign;    ///< Number sign; 0: positive, 1: negative.
+} number_bigint;
+
+/**
+ * Initialize a big integer with the value 0.
+ *
+ * @param big The big integer to be initialized.
+ * @param limbs The buffer of `cap` limbs, which has to be valid while the
+ * big integer is in use.
+ * @param cap The number of limbs in `limbs`.
+ */
+static inline void number_bigint_init(number_bigint* big, uint64_t* limbs, size_t cap) {
+	big->limbs = limbs;
+	big->len = 0;
+	big->cap = cap;
+	big->sign = 0;
+}
+
+/**
+ * Get the number of limbs which are sufficient for any integer with `digits`
+ * digits in `base`.
+ *
+ * @param digits The number of digits.
+ * @param base The number base between 2 and 255.
+ * @return The number of limbs.
+ */
+static inline size_t number_bigint_limbs(size_t digits, unsigned base) {
+	unsigned bits = 0;
+
+	// bits of the largest digit
+	for (unsigned b = base - 1; b; b >>= 1) {
+		bits ++;
+	}
+
+	return (digits * bits + 63) / 64 + 1;
+}
+
+/**
+ * Scan an integer in the string from `str` to `end` into `big`.
+ *
+ * Digits are accumulated in chunks which fit into a single limb, so each
+ * chunk needs one multiply-add pass over the limbs. Integers with several
+ * thousand digits are instead converted by divide and conquer, which
+ * allocates temporary memory and takes O(n log^2 n) time for n digits; if the
+ * allocation fails, the chunked conversion is used. Digits of power-of-two
+ * bases are stored directly.
+ *
+ * @param big The big integer to store the value in.
+ * @param desc The base descriptor.
+ * @param str The start of the string. Is set to the first character not
+ * consumed on success.
+ * @param end The end of the string.
+ * @param flags Only `NUMBER_PARSER_SCAN_SIGN` is accepted.
+ * @return `NUMBER_PARSER_OK` on success, `NUMBER_PARSER_ERR_INVALID` if
+ * the string does not start with an integer, or `NUMBER_PARSER_ERR_RANGE`
+ * if the value does not fit into the limbs of `big`.
+ */
+extern int number_bigint_scan(number_bigint* big, const number_base* desc, const char** str, const char* end, int flags);
+
+#ifdef __cplusplus
+}
+#endif
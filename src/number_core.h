@@ -0,0 +1,695 @@
+/*
+ * Copyright (c) 2016 Simon Schoenenberger
+ * https://github.com/detomon/number_parser
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+/**
+ * @file
+ *
+ * Conversion of parsed mantissas to `double` shared by number_parser_end() and
+ * basic_number_parser::end() in number_parser.hpp.
+ *
+ * The functions are written in the common subset of C99 and C++. In C, they
+ * are `static inline`. In C++, they are declared in
+ * `number_parsing::detail` and are `constexpr` with C++20, so the C++ parser
+ * gives the same results at compile time as the C functions at runtime.
+ * Constant expressions may not overflow to infinity, so products which may
+ * overflow use number_mul_pos().
+ */
+
+#pragma once
+
+#include <float.h>
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
+#include "number_parser.h"
+
+#define NUMBER_POW10_MIN -342 ///< The smallest power of ten in `number_pow10_tab`.
+#define NUMBER_POW10_MAX 324  ///< The largest power of ten in `number_pow10_tab`.
+#define NUMBER_MAX_POW10 308  ///< Larger powers of ten always overflow.
+#define NUMBER_MANT_BITS 52   ///< Number of explicit mantissa bits of `double`.
+#define NUMBER_INF_EXP 0x7FF  ///< Biased exponent of infinity.
+#define NUMBER_WIDE_LIMBS 48  ///< Number of limbs of `number_wide_big`.
+
+#ifdef __cplusplus
+
+#if __cplusplus >= 202002L
+#include <bit>
+#define NUMBER_CORE constexpr inline
+#else
+#define NUMBER_CORE inline
+#endif
+#define NUMBER_CORE_DATA constexpr
+
+namespace number_parsing {
+
+namespace detail {
+
+/**
+ * Normalized 128-bit powers of ten; see the C declaration below.
+ */
+constexpr uint64_t number_pow10_tab[NUMBER_POW10_MAX - NUMBER_POW10_MIN + 1][2] = {
+#include "number_pow10.inc"
+};
+
+#else
+
+#define NUMBER_CORE static inline
+#define NUMBER_CORE_DATA static const
+
+/**
+ * Normalized 128-bit approximations of the powers of ten between
+ * `NUMBER_POW10_MIN` and `NUMBER_POW10_MAX`.
+ *
+ * Each entry contains the high and low word of 10 ^ q scaled by a power of two
+ * so that the most significant bit is set. Entries are truncated, except for
+ * 10 ^ -27 to 10 ^ -1, which are rounded up.
+ */
+extern const uint64_t number_pow10_tab[NUMBER_POW10_MAX - NUMBER_POW10_MIN + 1][2];
+
+#endif
+
+/**
+ * Powers of ten which fit into 64 bits.
+ */
+NUMBER_CORE_DATA uint64_t number_int_pows_10[20] = {
+	1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL,
+	10000000ULL, 100000000ULL, 1000000000ULL, 10000000000ULL,
+	100000000000ULL, 1000000000000ULL, 10000000000000ULL,
+	100000000000000ULL, 1000000000000000ULL, 10000000000000000ULL,
+	100000000000000000ULL, 1000000000000000000ULL,
+	10000000000000000000ULL,
+};
+
+/**
+ * Multiply `a` and `b` and return the high word of the 128-bit product.
+ * The low word is stored in `lo`.
+ */
+NUMBER_CORE uint64_t number_mul128(uint64_t a, uint64_t b, uint64_t* lo) {
+#if defined(__SIZEOF_INT128__)
+	__extension__ typedef unsigned __int128 uint128;
+	uint128 p = (uint128) a * b;
+
+	*lo = (uint64_t) p;
+
+	return (uint64_t) (p >> 64);
+#else
+	uint64_t a0 = (uint32_t) a, a1 = a >> 32;
+	uint64_t b0 = (uint32_t) b, b1 = b >> 32;
+	uint64_t p00 = a0 * b0, p01 = a0 * b1;
+	uint64_t p10 = a1 * b0, p11 = a1 * b1;
+	uint64_t mid = (p00 >> 32) + (uint32_t) p01 + (uint32_t) p10;
+
+	*lo = (mid << 32) | (uint32_t) p00;
+
+	return p11 + (p01 >> 32) + (p10 >> 32) + (mid >> 32);
+#endif
+}
+
+/**
+ * Count the leading zero bits of `x`, which must not be 0.
+ */
+NUMBER_CORE int number_clz64(uint64_t x) {
+#if defined(__GNUC__)
+	return __builtin_clzll(x);
+#elif defined(__cplusplus) && __cplusplus >= 202002L
+	return std::countl_zero(x);
+#else
+	int n = 0;
+
+	while (!(x & ((uint64_t) 1 << 63))) {
+		x <<= 1;
+		n ++;
+	}
+
+	return n;
+#endif
+}
+
+/**
+ * Count the trailing zero bits of `x`, which must not be 0.
+ */
+NUMBER_CORE int number_ctz64(uint64_t x) {
+#if defined(__GNUC__)
+	return __builtin_ctzll(x);
+#elif defined(__cplusplus) && __cplusplus >= 202002L
+	return std::countr_zero(x);
+#else
+	int n = 0;
+
+	while (!(x & 1)) {
+		x >>= 1;
+		n ++;
+	}
+
+	return n;
+#endif
+}
+
+/**
+ * Get the bit representation of `value`.
+ */
+NUMBER_CORE uint64_t number_double_bits(double value) {
+#if defined(__cplusplus) && __cplusplus >= 202002L
+	return std::bit_cast<uint64_t>(value);
+#else
+	uint64_t bits;
+
+	memcpy(&bits, &value, sizeof(bits));
+
+	return bits;
+#endif
+}
+
+/**
+ * Get the double represented by `bits`.
+ */
+NUMBER_CORE double number_bits_double(uint64_t bits) {
+#if defined(__cplusplus) && __cplusplus >= 202002L
+	return std::bit_cast<double>(bits);
+#else
+	double value;
+
+	memcpy(&value, &bits, sizeof(value));
+
+	return value;
+#endif
+}
+
+/**
+ * Multiply `a` and `b`, which are at least 1. A product overflowing to
+ * infinity is detected with factors scaled by 2 ^ -512 first, which are
+ * exact.
+ */
+NUMBER_CORE double number_mul_pos(double a, double b) {
+	double scale = number_bits_double((uint64_t) (1023 - 512) << NUMBER_MANT_BITS);
+
+	return (a * scale) * (b * scale) >= 1.0 ? (double) INFINITY : a * b;
+}
+
+/**
+ * Calculate the double nearest to `w` * 10 ^ `q` using the Eisel-Lemire
+ * algorithm. The result is correctly rounded as long as `w` is exact.
+ */
+NUMBER_CORE double number_decimal_to_double(uint64_t w, int q) {
+	uint64_t lo = 0, hi, mant;
+	int lz, upper, shift, exp;
+
+	if (w == 0 || q < NUMBER_POW10_MIN) {
+		return 0.0;
+	}
+
+	if (q > NUMBER_MAX_POW10) {
+		return number_bits_double((uint64_t) NUMBER_INF_EXP << NUMBER_MANT_BITS);
+	}
+
+	lz = number_clz64(w);
+	w <<= lz;
+
+	const uint64_t* pow = number_pow10_tab[q - NUMBER_POW10_MIN];
+
+	hi = number_mul128(w, pow[0], &lo);
+
+	// the low word is only needed if the bits below the rounding bit are all
+	// set, as a carry may propagate
+	if ((hi & 0x1FF) == 0x1FF) {
+		uint64_t lo2 = 0, hi2 = number_mul128(w, pow[1], &lo2);
+
+		lo += hi2;
+		hi += hi2 > lo;
+	}
+
+	upper = (int) (hi >> 63);
+	shift = upper + 64 - NUMBER_MANT_BITS - 3;
+	mant = hi >> shift;
+	exp = (((152170 + 65536) * q) >> 16) + 63 + upper - lz + 1023;
+
+	// subnormal
+	if (exp <= 0) {
+		if (-exp + 1 >= 64) {
+			return 0.0;
+		}
+
+		mant >>= -exp + 1;
+		mant += mant & 1;
+		mant >>= 1;
+		exp = mant >= (uint64_t) 1 << NUMBER_MANT_BITS;
+
+		return number_bits_double(mant | ((uint64_t) exp << NUMBER_MANT_BITS));
+	}
+
+	// round to even if exactly halfway; this is only possible for small `q`
+	if (lo <= 1 && q >= -4 && q <= 23 && (mant & 3) == 1) {
+		if ((mant << shift) == hi) {
+			mant &= ~(uint64_t) 1;
+		}
+	}
+
+	mant += mant & 1;
+	mant >>= 1;
+
+	if (mant >= (uint64_t) 2 << NUMBER_MANT_BITS) {
+		mant = (uint64_t) 1 << NUMBER_MANT_BITS;
+		exp ++;
+	}
+
+	mant &= ~((uint64_t) 1 << NUMBER_MANT_BITS);
+
+	if (exp >= NUMBER_INF_EXP) {
+		exp = NUMBER_INF_EXP;
+		mant = 0;
+	}
+
+	return number_bits_double(mant | ((uint64_t) exp << NUMBER_MANT_BITS));
+}
+
+/**
+ * A big unsigned integer with `len` 32-bit limbs, which is large enough to
+ * compare decimal numbers in the range of double with halfway points.
+ */
+typedef struct {
+	int len;
+	uint32_t limbs[NUMBER_WIDE_LIMBS];
+} number_wide_big;
+
+/**
+ * Multiply `big` by `mul`.
+ */
+NUMBER_CORE void number_wide_big_mul(number_wide_big* big, uint32_t mul) {
+	uint64_t carry = 0;
+
+	for (int i = 0; i < big->len; i ++) {
+		carry += (uint64_t) big->limbs[i] * mul;
+		big->limbs[i] = (uint32_t) carry;
+		carry >>= 32;
+	}
+
+	if (carry) {
+		big->limbs[big->len ++] = (uint32_t) carry;
+	}
+}
+
+/**
+ * Set `big` to `w` * 5 ^ `n` * 2 ^ `shift`.
+ */
+NUMBER_CORE void number_wide_big_set(number_wide_big* big, const uint64_t w[2], int n, int shift) {
+	int words = shift / 32;
+	int bits = shift % 32;
+	uint32_t carry = 0;
+
+	for (big->len = 0; big->len < words; big->len ++) {
+		big->limbs[big->len] = 0;
+	}
+
+	for (int i = 0; i < 4; i ++) {
+		big->limbs[big->len ++] = (uint32_t) (w[i / 2] >> (i % 2 * 32));
+	}
+
+	for (; n >= 13; n -= 13) {
+		number_wide_big_mul(big, 1220703125); // 5 ^ 13
+	}
+
+	for (; n > 0; n --) {
+		number_wide_big_mul(big, 5);
+	}
+
+	for (int i = words; i < big->len; i ++) {
+		uint32_t limb = big->limbs[i];
+
+		big->limbs[i] = (limb << bits) | carry;
+		carry = bits ? limb >> (32 - bits) : 0;
+	}
+
+	big->limbs[big->len ++] = carry;
+
+	while (big->len && !big->limbs[big->len - 1]) {
+		big->len --;
+	}
+}
+
+/**
+ * Compare `a` with `b`. Returns -1, 0 or 1.
+ */
+NUMBER_CORE int number_wide_big_cmp(const number_wide_big* a, const number_wide_big* b) {
+	if (a->len != b->len) {
+		return a->len < b->len ? -1 : 1;
+	}
+
+	for (int i = a->len - 1; i >= 0; i --) {
+		if (a->limbs[i] != b->limbs[i]) {
+			return a->limbs[i] < b->limbs[i] ? -1 : 1;
+		}
+	}
+
+	return 0;
+}
+
+/**
+ * Calculate the double nearest to `w` * 10 ^ `q` for the 128-bit mantissa `w`.
+ *
+ * The mantissa is truncated to fewer than 20 digits first. If the truncated
+ * mantissa and its successor round to the same double, the result is
+ * correct. Otherwise, the exact value is compared with the halfway point
+ * between both results.
+ *
+ * If `sticky` is set, nonzero digits were dropped after `w`. As the dropped
+ * digits are not known, they only decide whether a mantissa equal to the
+ * halfway point rounds up; a value which differs from the halfway point only
+ * in the dropped digits is rounded down unless `round_up` is set.
+ */
+NUMBER_CORE double number_wide_decimal_to_double(const uint64_t w[2], int q, int sticky, int round_up) {
+	uint64_t t, bits, m;
+	int k = 0, inexact = 0, e, cmp;
+	double lower, upper;
+	number_wide_big a, b;
+
+#if defined(__SIZEOF_INT128__)
+#define POW10_128(n) ((uint128) number_int_pows_10[(n) < 19 ? (n) : 19] * number_int_pows_10[(n) < 19 ? 0 : (n) - 19])
+	__extension__ typedef unsigned __int128 uint128;
+	uint128 v = ((uint128) w[1] << 64) | w[0];
+	uint128 d;
+	int len = w[1] ? 128 - number_clz64(w[1]) : 64 - number_clz64(w[0]);
+	int digits = (((len - 1) * 1233) >> 12) + 1;
+
+	// the estimated number of digits from the bit length may be one less
+	digits += digits < 39 && v >= POW10_128(digits);
+
+	// keep 19 digits
+	k = digits - 19;
+	d = POW10_128(k);
+	t = (uint64_t) (v / d);
+	inexact = v != t * d;
+#undef POW10_128
+#else
+	uint32_t limbs[4] = {(uint32_t) w[0], (uint32_t) (w[0] >> 32), (uint32_t) w[1], (uint32_t) (w[1] >> 32)};
+
+	// divide by 10 until the truncated mantissa plus 1 fits into 64 bits
+	while (limbs[3] || limbs[2] || limbs[1] == UINT32_MAX) {
+		uint64_t rem = 0;
+
+		for (int i = 3; i >= 0; i --) {
+			rem = (rem << 32) | limbs[i];
+			limbs[i] = (uint32_t) (rem / 10);
+			rem %= 10;
+		}
+
+		inexact |= rem != 0;
+		k ++;
+	}
+
+	t = ((uint64_t) limbs[1] << 32) | limbs[0];
+#endif
+
+	lower = number_decimal_to_double(t, q + k);
+	inexact |= sticky;
+
+	if (!inexact) {
+		return lower;
+	}
+
+	upper = number_decimal_to_double(t + 1, q + k);
+
+	if (lower == upper) {
+		return lower;
+	}
+
+	// the dropped digits were compared with the halfway point by
+	// number_parser_scan()
+	if (round_up) {
+		return upper;
+	}
+
+	// the halfway point is (2 * `m` + 1) * 2 ^ (`e` - 1)
+	bits = number_double_bits(lower);
+	m = bits & (((uint64_t) 1 << NUMBER_MANT_BITS) - 1);
+	e = (int) (bits >> NUMBER_MANT_BITS);
+
+	// subnormal numbers have no hidden bit
+	if (e) {
+		m |= (uint64_t) 1 << NUMBER_MANT_BITS;
+	}
+	else {
+		e = 1;
+	}
+
+	e -= 1023 + NUMBER_MANT_BITS;
+
+	const uint64_t half[2] = {2 * m + 1, 0};
+	int shift = q - (e - 1);
+
+	number_wide_big_set(&a, w, q > 0 ? q : 0, shift > 0 ? shift : 0);
+	number_wide_big_set(&b, half, q < 0 ? -q : 0, shift < 0 ? -shift : 0);
+	cmp = number_wide_big_cmp(&a, &b);
+
+	if (cmp == 0) {
+		return (m & 1) || sticky ? upper : lower;
+	}
+
+	return cmp > 0 ? upper : lower;
+}
+
+/**
+ * Round `r` * 2 ^ (`e` - 63) to a binary floating-point format with
+ * `mant_bits` explicit mantissa bits and exponent bias `bias`. The bits of the
+ * positive result are returned. `r` must be normalized.
+ */
+NUMBER_CORE uint64_t number_round_binary(uint64_t r, int e, int mant_bits, int bias) {
+	uint64_t inf = (uint64_t) (bias * 2 + 1) << mant_bits;
+	int be = e + bias;
+	int shift = 63 - mant_bits;
+	uint64_t m, rem, half, bits;
+
+	// subnormal numbers have less bits
+	if (be < 1) {
+		shift += 1 - be;
+		be = 1;
+	}
+
+	if (shift > 64) {
+		return 0;
+	}
+	else if (shift == 64) {
+		// rounds up unless exactly halfway
+		return r > (uint64_t) 1 << 63;
+	}
+
+	m = r >> shift;
+	rem = r & (((uint64_t) 1 << shift) - 1);
+	half = (uint64_t) 1 << (shift - 1);
+
+	if (rem > half || (rem == half && (m & 1))) {
+		m ++;
+	}
+
+	// the hidden bit and a carry of `m` increment the exponent
+	bits = ((uint64_t) (be - 1) << mant_bits) + m;
+
+	return bits >= inf ? inf : bits;
+}
+
+/**
+ * Get the 128-bit mantissa `w` shifted up to the top bit like
+ * number_round_binary() expects it and store the exponent of the top bit in
+ * `e`. The bits below the top 64 bits and `sticky` are folded into the lowest
+ * bit, which is below the rounding position of any format with less than 63
+ * mantissa bits. `w` must not be 0.
+ */
+NUMBER_CORE uint64_t number_wide_mant(const uint64_t w[2], int sticky, int* e) {
+	int lz;
+
+	if (!w[1]) {
+		lz = number_clz64(w[0]);
+		*e = 63 - lz;
+
+		return (w[0] << lz) | (sticky != 0);
+	}
+
+	lz = number_clz64(w[1]);
+	*e = 127 - lz;
+
+	if (!lz) {
+		return w[1] | (w[0] != 0 || sticky);
+	}
+
+	return (w[1] << lz) | (w[0] >> (64 - lz)) | ((w[0] << lz) != 0 || sticky);
+}
+
+/**
+ * Get the mantissa of the positive normal `value` shifted up to the top bit
+ * and store its binary exponent in `e` like number_round_binary() expects
+ * them.
+ */
+NUMBER_CORE uint64_t number_double_mant(double value, int* e) {
+	uint64_t bits = number_double_bits(value);
+
+	*e = (int) (bits >> NUMBER_MANT_BITS) - 1023;
+
+	return (bits << (63 - NUMBER_MANT_BITS)) | (uint64_t) 1 << 63;
+}
+
+/**
+ * Scale the positive normal `*value` to between 1 and 2 and return the binary
+ * exponent it was scaled by.
+ */
+NUMBER_CORE int number_split_exp(double* value) {
+	uint64_t bits = number_double_bits(*value);
+
+	*value = number_bits_double((bits & (((uint64_t) 1 << NUMBER_MANT_BITS) - 1)) | (uint64_t) 1023 << NUMBER_MANT_BITS);
+
+	return (int) (bits >> NUMBER_MANT_BITS) - 1023;
+}
+
+/**
+ * Divide the positive integer `value` by `base` ^ `n` for subnormal results.
+ * The power is kept between 1 and 2 with a separate binary exponent, so it
+ * never overflows, and the exponent is applied to the quotient by
+ * number_round_binary().
+ */
+NUMBER_CORE double number_scale_down(double value, int base, int n) {
+	double d = base;
+	double e = 1.0;
+	int d_exp = number_split_exp(&d);
+	int exp = number_split_exp(&value);
+	uint64_t r;
+	int q_exp = 0;
+
+	for (; n; n >>= 1) {
+		if (n & 1) {
+			e *= d;
+			exp -= d_exp + number_split_exp(&e);
+		}
+
+		d *= d;
+		d_exp = d_exp * 2 + number_split_exp(&d);
+	}
+
+	r = number_double_mant(value / e, &q_exp);
+
+	return number_bits_double(number_round_binary(r, exp + q_exp, NUMBER_MANT_BITS, 1023));
+}
+
+/**
+ * Calculate the magnitude of the floating-point value of `parser` after
+ * its trailing zeros and overflow were resolved by the end function.
+ *
+ * `mant` is the integer mantissa if `is_exact` is set; otherwise, the mantissa
+ * is in `wide`. `pows` are the powers `base` ^ (2 ^ i) of
+ * `number_base.pows`, or NULL to square the base while scaling.
+ */
+NUMBER_CORE double number_float_value(const number_parser* parser, int is_exact, uint64_t mant, const double* pows) {
+	int base = parser->base;
+	int n = parser->exp_sign ? -parser->exp_val : parser->exp_val;
+	double value;
+	double d = base;
+	double e = 1.0;
+	int neg, k;
+
+	// trailing zeros of the fraction do not change the value
+	if (parser->rad_off >= 0) {
+		n -= parser->int_len - parser->rad_off;
+	}
+	else {
+		n += parser->zero_len;
+	}
+
+	// decimal numbers with an exact mantissa can be correctly rounded
+	if (base == 10) {
+		return is_exact ? number_decimal_to_double(mant, n) : number_wide_decimal_to_double(parser->wide, n + parser->wide_drop, parser->is_sticky, parser->round_up);
+	}
+
+	if (!is_exact) {
+		n += parser->wide_drop;
+	}
+
+	// a power of two base only moves the binary point, so the exact
+	// mantissa is rounded once
+	if ((base & (base - 1)) == 0) {
+		uint64_t r;
+		long exp;
+		int top = 0;
+
+		if (!is_exact) {
+			r = number_wide_mant(parser->wide, parser->is_sticky, &top);
+		}
+		else if (mant) {
+			top = 63 - number_clz64(mant);
+			r = mant << (63 - top);
+		}
+		else {
+			return 0.0;
+		}
+
+		exp = (long) n * number_ctz64(base) + top;
+
+		// saturate; larger exponents overflow anyway
+		exp = exp < -(1 << 14) ? -(1 << 14) : exp > (1 << 14) ? (1 << 14) : exp;
+
+		return number_bits_double(number_round_binary(r, (int) exp, NUMBER_MANT_BITS, 1023));
+	}
+
+	if (is_exact) {
+		value = (double) mant;
+	}
+	else {
+		int top = 0;
+		uint64_t r = number_wide_mant(parser->wide, parser->is_sticky, &top);
+
+		value = number_bits_double(number_round_binary(r, top, NUMBER_MANT_BITS, 1023));
+	}
+
+	// a nonzero mantissa is an integer of at least 1 and below 2 ^ 128, so
+	// larger powers saturate to infinity or zero without scaling
+	if (value == 0.0 || n <= -2100) {
+		return 0.0;
+	}
+	else if (n >= 1024) {
+		return (double) INFINITY;
+	}
+
+	neg = n < 0;
+	k = neg ? -n : n;
+
+	for (int i = 0; k; i ++, k >>= 1) {
+		if (k & 1) {
+			e = number_mul_pos(e, pows ? pows[i] : d);
+		}
+
+		if (!pows) {
+			d = number_mul_pos(d, d);
+		}
+	}
+
+	if (neg) {
+		double q = value / e;
+
+		// the power may have overflowed
+		return q < DBL_MIN ? number_scale_down(value, base, -n) : q;
+	}
+
+	return number_mul_pos(value, e);
+}
+
+#ifdef __cplusplus
+} // namespace detail
+
+} // namespace number_parsing
+#endif
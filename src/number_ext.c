@@ -0,0 +1,724 @@
+/*
+ * Copyright (c) 2016 Simon Schoenenberger
+ * https://github.com/detomon/number_parser
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include <math.h>
+#include "number_parser.h"
+#include "number_internal.h"
+
+#define EXT_DIGITS 1200    // number of significant digits kept exactly
+#define EXT_LEN 520        // number of 32-bit limbs to hold 5 ^ 6170 or 10 ^ 1201 * 5 ^ 4933
+#define EXT_MAX_EXP 4933   // larger decimal exponents always overflow
+#define EXT_MIN_EXP -4966  // smaller decimal exponents always underflow
+#define EXT_EXP_LIMIT 100000
+#define EXT_PREC 116       // precision of the fast path
+#define POW5_13 1220703125 // 5 ^ 13
+
+/**
+ * A big unsigned integer with `len` limbs in `limbs`.
+ */
+typedef struct {
+	int len;
+	uint32_t limbs[EXT_LEN];
+} ext_big;
+
+/**
+ * A decimal number `digits` * 10 ^ `exp` scanned by scan_decimal().
+ */
+typedef struct {
+	const char* digits; ///< First significant digit.
+	long exp;           ///< Exponent of the last significant digit.
+	long count;         ///< Number of significant digits.
+	uint64_t mant[2];   ///< Significant digits if `count` <= 38; low word first.
+	int sign;           ///< Number sign.
+} ext_decimal;
+
+static void big_set(ext_big* big, uint64_t value) {
+	big->limbs[0] = (uint32_t) value;
+	big->limbs[1] = (uint32_t) (value >> 32);
+	big->len = big->limbs[1] ? 2 : big->limbs[0] ? 1 : 0;
+}
+
+/**
+ * Multiply `big` by `mul` and add `add`.
+ */
+static void big_mul_add(ext_big* big, uint32_t mul, uint32_t add) {
+	uint64_t carry = add;
+
+	for (int i = 0; i < big->len; i ++) {
+		carry += (uint64_t) big->limbs[i] * mul;
+		big->limbs[i] = (uint32_t) carry;
+		carry >>= 32;
+	}
+
+	if (carry) {
+		big->limbs[big->len ++] = (uint32_t) carry;
+	}
+}
+
+static void big_mul_pow5(ext_big* big, long n) {
+	static const uint32_t pows_5[13] = {
+		1, 5, 25, 125, 625, 3125, 15625, 78125, 390625, 1953125, 9765625,
+		48828125, 244140625,
+	};
+
+	for (; n >= 13; n -= 13) {
+		big_mul_add(big, POW5_13, 0);
+	}
+
+	big_mul_add(big, pows_5[n], 0);
+}
+
+static int big_bit_len(const ext_big* big) {
+	if (!big->len) {
+		return 0;
+	}
+
+	return big->len * 32 - (number_clz64(big->limbs[big->len - 1]) - 32);
+}
+
+static void big_shl(ext_big* big, int n) {
+	int words = n / 32;
+	int bits = n % 32;
+
+	if (!big->len) {
+		return;
+	}
+
+	big->limbs[big->len] = 0;
+
+	for (int i = big->len; i >= 0; i --) {
+		uint32_t limb = big->limbs[i] << bits;
+
+		if (bits && i > 0) {
+			limb |= big->limbs[i - 1] >> (32 - bits);
+		}
+
+		big->limbs[i + words] = limb;
+	}
+
+	memset(big->limbs, 0, words * sizeof(*big->limbs));
+	big->len += words + 1;
+
+	while (big->len && !big->limbs[big->len - 1]) {
+		big->len --;
+	}
+}
+
+static int big_cmp(const ext_big* a, const ext_big* b) {
+	if (a->len != b->len) {
+		return a->len < b->len ? -1 : 1;
+	}
+
+	for (int i = a->len - 1; i >= 0; i --) {
+		if (a->limbs[i] != b->limbs[i]) {
+			return a->limbs[i] < b->limbs[i] ? -1 : 1;
+		}
+	}
+
+	return 0;
+}
+
+/**
+ * Subtract `b` from `a`, which must not be less than `b`.
+ */
+static void big_sub(ext_big* a, const ext_big* b) {
+	int64_t borrow = 0;
+
+	for (int i = 0; i < a->len; i ++) {
+		borrow += (int64_t) a->limbs[i] - (i < b->len ? b->limbs[i] : 0);
+		a->limbs[i] = (uint32_t) borrow;
+		borrow >>= 32;
+	}
+
+	while (a->len && !a->limbs[a->len - 1]) {
+		a->len --;
+	}
+}
+
+/**
+ * Get the 128 most significant bits of `big` rounded to odd. Returns the bit
+ * length of `big`.
+ */
+static int big_top128(const ext_big* big, uint64_t* hi, uint64_t* lo) {
+	int len = big_bit_len(big);
+	int sticky = 0;
+	uint64_t h = 0, l = 0;
+
+	for (int i = len - 1; i >= 0 && i >= len - 128; i --) {
+		uint64_t bit = (big->limbs[i / 32] >> (i % 32)) & 1;
+
+		h = (h << 1) | (l >> 63);
+		l = (l << 1) | bit;
+	}
+
+	for (int i = 0; i < len - 128 && !sticky; i ++) {
+		sticky = (big->limbs[i / 32] >> (i % 32)) & 1;
+	}
+
+	// left-align shorter numbers
+	for (int i = len; i < 128; i ++) {
+		h = (h << 1) | (l >> 63);
+		l <<= 1;
+	}
+
+	*hi = h;
+	*lo = l | sticky;
+
+	return len;
+}
+
+/**
+ * Calculate the exact value of `num` * 10 ^ `exp` rounded to odd with 128 bits.
+ * The result is normalized so that bit 127 is set. Returns the exponent of
+ * bit 127. `num` must not be 0 and is modified.
+ */
+static int big_to_odd128(ext_big* num, long exp, uint64_t* hi, uint64_t* lo) {
+	ext_big den;
+	uint64_t h = 0, l = 0;
+	int shift;
+
+	if (exp >= 0) {
+		big_mul_pow5(num, exp);
+
+		return big_top128(num, hi, lo) - 1 + (int) exp;
+	}
+
+	big_set(&den, 1);
+	big_mul_pow5(&den, -exp);
+
+	// scale the numerator so that `den` <= `num` < 2 * `den`
+	shift = big_bit_len(&den) - big_bit_len(num);
+
+	if (shift > 0) {
+		big_shl(num, shift);
+	}
+	else {
+		big_shl(&den, -shift);
+	}
+
+	if (big_cmp(num, &den) < 0) {
+		big_shl(num, 1);
+		shift ++;
+	}
+
+	for (int i = 0; i < 128; i ++) {
+		uint64_t bit = big_cmp(num, &den) >= 0;
+
+		if (bit) {
+			big_sub(num, &den);
+		}
+
+		h = (h << 1) | (l >> 63);
+		l = (l << 1) | bit;
+		big_shl(num, 1);
+	}
+
+	*hi = h;
+	*lo = l | (num->len != 0);
+
+	return (int) (exp - shift);
+}
+
+/**
+ * Calculate the exact value of `dec` rounded to odd with 128 bits using big
+ * integers. The result is normalized so that bit 127 is set. Returns the
+ * exponent of bit 127.
+ */
+static int decimal_to_odd128_big(const ext_decimal* dec, uint64_t* hi, uint64_t* lo) {
+	ext_big num;
+	const char* s = dec->digits;
+	long count = dec->count < EXT_DIGITS ? dec->count : EXT_DIGITS;
+	long exp = dec->exp + (dec->count - count);
+	int nonzero = 0;
+
+	big_set(&num, 0);
+
+	for (long n = 0; n < count; s ++) {
+		if (*s != '.') {
+			big_mul_add(&num, 10, *s - '0');
+			n ++;
+		}
+	}
+
+	// digits which are not kept are only considered to be nonzero
+	for (long n = count; n < dec->count && !nonzero; s ++) {
+		if (*s != '.') {
+			nonzero = *s != '0';
+			n ++;
+		}
+	}
+
+	if (nonzero) {
+		big_mul_add(&num, 10, 1);
+		exp --;
+	}
+
+	return big_to_odd128(&num, exp, hi, lo);
+}
+
+/**
+ * Calculate `w` * 10 ^ `q` rounded to odd with at least `EXT_PREC` bits from
+ * the 256-bit product of the 128-bit mantissa `w` with the power-of-ten table.
+ * The result is normalized so that bit 127 is set and the exponent of bit 127
+ * is stored in `e`.
+ *
+ * Returns 0 if the result cannot be determined because the truncation error
+ * may carry into the result bits or the value may be exact.
+ */
+static int decimal_to_odd128(const uint64_t w[2], int q, uint64_t* hi, uint64_t* lo, int* e) {
+	uint64_t w1 = w[1], w0 = w[0];
+	uint64_t p[4], t, c, rem;
+	uint64_t mask = ((uint64_t) 1 << (128 - EXT_PREC)) - 1;
+	int lz, upper;
+
+	if (q < NUMBER_POW10_MIN || q > NUMBER_POW10_MAX) {
+		return 0;
+	}
+
+	lz = w1 ? number_clz64(w1) : 64 + number_clz64(w0);
+
+	if (lz >= 64) {
+		w1 = w0 << (lz - 64);
+		w0 = 0;
+	}
+	else if (lz) {
+		w1 = (w1 << lz) | (w0 >> (64 - lz));
+		w0 <<= lz;
+	}
+
+	const uint64_t* pow = number_pow10_tab[q - NUMBER_POW10_MIN];
+
+	// 256-bit product `p`
+	p[3] = number_mul128(w1, pow[0], &p[2]);
+	p[1] = number_mul128(w0, pow[1], &p[0]);
+	t = number_mul128(w1, pow[1], &c);
+	p[1] += c;
+	t += p[1] < c;
+	p[2] += t;
+	p[3] += p[2] < t;
+	t = number_mul128(w0, pow[0], &c);
+	p[1] += c;
+	t += p[1] < c;
+	p[2] += t;
+	p[3] += p[2] < t;
+
+	upper = (int) (p[3] >> 63);
+	*e = ((217706 * q) >> 16) + 127 + upper - lz;
+
+	if (!upper) {
+		p[3] = (p[3] << 1) | (p[2] >> 63);
+		p[2] = (p[2] << 1) | (p[1] >> 63);
+		p[1] = (p[1] << 1) | (p[0] >> 63);
+		p[0] <<= 1;
+	}
+
+	// the product is exact for powers of ten between 0 and 55
+	if (q >= 0 && q <= 55) {
+		*hi = p[3];
+		*lo = p[2] | ((p[1] | p[0]) != 0);
+
+		return 1;
+	}
+
+	// the error of the product is less than 2 units of `rem` and may carry
+	// into or borrow from the result bits if the bits below are almost all
+	// ones or zeros; exact values have all lower bits cleared
+	rem = p[2] & mask;
+
+	if (rem < 8 || rem > mask - 8) {
+		return 0;
+	}
+
+	*hi = p[3];
+	*lo = (p[2] & ~mask) | 1;
+
+	return 1;
+}
+
+int number_wide_to_odd128(const uint64_t w[2], int q, int sticky, uint64_t* hi, uint64_t* lo) {
+	ext_big num;
+	int e;
+
+	if (!sticky && decimal_to_odd128(w, q, hi, lo, &e)) {
+		return e;
+	}
+
+	num.limbs[0] = (uint32_t) w[0];
+	num.limbs[1] = (uint32_t) (w[0] >> 32);
+	num.limbs[2] = (uint32_t) w[1];
+	num.limbs[3] = (uint32_t) (w[1] >> 32);
+	num.len = 4;
+
+	while (num.len && !num.limbs[num.len - 1]) {
+		num.len --;
+	}
+
+	// dropped digits are only considered to be nonzero like in
+	// decimal_to_odd128_big()
+	if (sticky) {
+		big_mul_add(&num, 10, 1);
+		q --;
+	}
+
+	return big_to_odd128(&num, q, hi, lo);
+}
+
+/**
+ * Round `hi`:`lo` * 2 ^ (`e` - 127) to `prec` bits with the minimum exponent
+ * `min_exp` of normal numbers. `hi` must be normalized.
+ *
+ * The rounded mantissa is stored in `hi`:`lo` and the exponent of its least
+ * significant bit in `e`.
+ */
+static void round_ext(uint64_t* hi, uint64_t* lo, int* e, int prec, int min_exp) {
+	uint64_t h = *hi, l = *lo;
+	int shift = 128 - prec;
+	int round, sticky;
+
+	// subnormal numbers have less bits
+	if (*e < min_exp) {
+		shift += min_exp - *e;
+	}
+
+	if (shift > 128) {
+		*hi = *lo = 0;
+		*e = 0;
+		return;
+	}
+
+	round = shift - 1 >= 64 ? (h >> (shift - 1 - 64)) & 1 : (l >> (shift - 1)) & 1;
+	sticky = shift - 1 >= 64 ? l != 0 || (h & (((uint64_t) 1 << (shift - 1 - 64)) - 1)) : (l & (((uint64_t) 1 << (shift - 1)) - 1)) != 0;
+
+	if (shift == 128) {
+		h = l = 0;
+	}
+	else if (shift >= 64) {
+		l = h >> (shift - 64);
+		h = 0;
+	}
+	else {
+		l = (l >> shift) | (h << (64 - shift));
+		h >>= shift;
+	}
+
+	if (round && (sticky || (l & 1))) {
+		l ++;
+		h += l == 0;
+	}
+
+	*hi = h;
+	*lo = l;
+	*e = *e - 127 + shift;
+}
+
+/**
+ * Append `len` <= 19 digits with value `chunk` to the 128-bit mantissa.
+ */
+static void mant_add_chunk(ext_decimal* dec, uint64_t chunk, int len) {
+	static const uint64_t pows[20] = {
+		1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL,
+		10000000ULL, 100000000ULL, 1000000000ULL, 10000000000ULL,
+		100000000000ULL, 1000000000000ULL, 10000000000000ULL,
+		100000000000000ULL, 1000000000000000ULL, 10000000000000000ULL,
+		100000000000000000ULL, 1000000000000000000ULL,
+		10000000000000000000ULL,
+	};
+	uint64_t lo;
+	uint64_t hi = number_mul128(dec->mant[0], pows[len], &lo);
+
+	dec->mant[0] = lo + chunk;
+	dec->mant[1] = dec->mant[1] * pows[len] + hi + (dec->mant[0] < lo);
+}
+
+/**
+ * Scan a decimal number like number_parser_scan() with base 10, but without
+ * limiting the number of significant digits or the exponent.
+ */
+static const char* scan_decimal(ext_decimal* dec, const char* str, const char* end, int flags) {
+	const char* s = str;
+	long exp = 0;
+	int has_digits = 0;
+	int rad_point = 0;
+	uint64_t chunk = 0;
+	int chunk_len = 0;
+
+	*dec = (ext_decimal) {0};
+
+	if ((flags & NUMBER_PARSER_SCAN_SIGN) && s < end && *s == '-') {
+		dec->sign = 1;
+		s ++;
+	}
+
+	for (; s < end; s ++) {
+		if (*s >= '0' && *s <= '9') {
+			has_digits = 1;
+
+			if (rad_point) {
+				exp --;
+			}
+
+			if (dec->count || *s != '0') {
+				if (!dec->count) {
+					dec->digits = s;
+				}
+
+				if (dec->count < 38) {
+					chunk = chunk * 10 + (*s - '0');
+
+					if (++ chunk_len == 19) {
+						mant_add_chunk(dec, chunk, chunk_len);
+						chunk = chunk_len = 0;
+					}
+				}
+
+				dec->count ++;
+			}
+		}
+		else if (*s == '.' && (flags & NUMBER_PARSER_SCAN_RAD_POINT) && !rad_point) {
+			// a radix point needs at least one integer or fractional digit
+			if (!has_digits && !(s + 1 < end && s[1] >= '0' && s[1] <= '9')) {
+				break;
+			}
+
+			rad_point = 1;
+		}
+		else {
+			break;
+		}
+	}
+
+	if (!has_digits) {
+		return str;
+	}
+
+	mant_add_chunk(dec, chunk, chunk_len);
+
+	// the exponent of the last significant digit
+	dec->exp = exp;
+
+	if ((flags & (NUMBER_PARSER_SCAN_EXP | NUMBER_PARSER_SCAN_EXP_REQUIRED)) && s < end && (*s | 0x20) == 'e') {
+		const char* e = s + 1;
+		const char* digits;
+		int negative = 0;
+		long value = 0;
+
+		if (e < end && (*e == '-' || *e == '+')) {
+			negative = *e == '-';
+			e ++;
+		}
+
+		for (digits = e; e < end && *e >= '0' && *e <= '9'; e ++) {
+			// saturate; larger values overflow anyway
+			if (value < EXT_EXP_LIMIT) {
+				value = value * 10 + (*e - '0');
+			}
+		}
+
+		if (e > digits) {
+			dec->exp += negative ? -value : value;
+
+			return e;
+		}
+	}
+
+	if (flags & NUMBER_PARSER_SCAN_EXP_REQUIRED) {
+		return str;
+	}
+
+	return s;
+}
+
+/**
+ * Round `dec` to `prec` bits with the minimum exponent `min_exp` and maximum
+ * exponent `max_exp` of normal numbers.
+ *
+ * The mantissa is stored in `hi`:`lo` and the exponent of its least significant
+ * bit in `e`. Returns 1 if the value overflows.
+ */
+static int decimal_to_ext(const ext_decimal* dec, int prec, int min_exp, int max_exp, uint64_t* hi, uint64_t* lo, int* e) {
+	long mag = dec->count + dec->exp;
+
+	*hi = *lo = 0;
+	*e = 0;
+
+	// the value is less than 10 ^ `mag`
+	if (!dec->count || mag < EXT_MIN_EXP) {
+		return 0;
+	}
+
+	if (mag - 1 > EXT_MAX_EXP) {
+		return 1;
+	}
+
+	// the mantissa has to be exact for the fast path
+	if (dec->count > 38 || !decimal_to_odd128(dec->mant, (int) dec->exp, hi, lo, e)) {
+		*e = decimal_to_odd128_big(dec, hi, lo);
+	}
+
+	round_ext(hi, lo, e, prec, min_exp);
+
+	// the mantissa has at most `prec` + 1 bits after rounding
+	if (*hi || *lo) {
+		int len = *hi ? 128 - number_clz64(*hi) : 64 - number_clz64(*lo);
+
+		return *e + len - 1 > max_exp;
+	}
+
+	return 0;
+}
+
+/**
+ * Convert the rounded mantissa `hi`:`lo` * 2 ^ `e` with `prec` bits to the
+ * fields of an IEEE interchange format. The mantissa is returned with its
+ * leading bit and the biased exponent is 0 for subnormal numbers.
+ */
+static int ext_pack(uint64_t* hi, uint64_t* lo, int e, int prec, int min_exp) {
+	int len = *hi ? 128 - number_clz64(*hi) : *lo ? 64 - number_clz64(*lo) : 0;
+
+	if (!len) {
+		return 0;
+	}
+
+	// rounding carried into the next bit
+	if (len > prec) {
+		*lo = (*lo >> 1) | (*hi << 63);
+		*hi >>= 1;
+		e ++;
+		len --;
+	}
+
+	// subnormal numbers already have the minimum exponent
+	if (e + len - 1 < min_exp) {
+		return 0;
+	}
+
+	return e + len - min_exp;
+}
+
+double number_ext_decimal_to_double(const char* str, const char* end, int flags) {
+	ext_decimal dec;
+	uint64_t hi, lo;
+	int e;
+
+	scan_decimal(&dec, str, end, flags);
+
+	if (decimal_to_ext(&dec, DBL_MANT_DIG, DBL_MIN_EXP - 1, DBL_MAX_EXP - 1, &hi, &lo, &e)) {
+		return HUGE_VAL;
+	}
+
+	e = ext_pack(&hi, &lo, e, DBL_MANT_DIG, DBL_MIN_EXP - 1);
+
+	return number_bits_double((uint64_t) e << (DBL_MANT_DIG - 1) | (lo & (((uint64_t) 1 << (DBL_MANT_DIG - 1)) - 1)));
+}
+
+const char* number_parser_scan_long_double(const char* str, const char* end, int flags, long double* value) {
+	ext_decimal dec;
+	uint64_t hi, lo;
+	int e, overflow;
+	long double result;
+	const char* s = scan_decimal(&dec, str, end, flags);
+
+	if (s == str) {
+		return str;
+	}
+
+	overflow = decimal_to_ext(&dec, LDBL_MANT_DIG, LDBL_MIN_EXP - 1, LDBL_MAX_EXP - 1, &hi, &lo, &e);
+
+	if (overflow) {
+		result = HUGE_VALL;
+	}
+	else {
+#if LDBL_MANT_DIG == 64 && LDBL_MAX_EXP == 16384 && (defined(__i386__) || defined(__x86_64__))
+		// x87 extended format with explicit integer bit
+		uint16_t exp = ext_pack(&hi, &lo, e, LDBL_MANT_DIG, LDBL_MIN_EXP - 1);
+
+		result = 0;
+		memcpy(&result, &lo, sizeof(lo));
+		memcpy((char*) &result + sizeof(lo), &exp, sizeof(exp));
+#else
+		// the mantissa is exact and scaling by powers of two is exact as the
+		// intermediate values are not less than the result
+		long double pow;
+
+		result = (long double) hi * 18446744073709551616.0L + (long double) lo;
+		pow = e < 0 ? 0.5L : 2.0L;
+
+		for (unsigned n = e < 0 ? -e : e; n; n >>= 1) {
+			if (n & 1) {
+				result *= pow;
+			}
+
+			pow *= pow;
+		}
+#endif
+	}
+
+	*value = dec.sign ? -result : result;
+
+	return s;
+}
+
+#if defined(__SIZEOF_FLOAT128__)
+const char* number_parser_scan_float128(const char* str, const char* end, int flags, __float128* value) {
+	ext_decimal dec;
+	uint64_t hi, lo;
+	int e, overflow;
+	__float128 result;
+	const char* s = scan_decimal(&dec, str, end, flags);
+
+	if (s == str) {
+		return str;
+	}
+
+	overflow = decimal_to_ext(&dec, 113, -16382, 16383, &hi, &lo, &e);
+
+	if (overflow) {
+		result = HUGE_VAL;
+	}
+	else {
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+		uint64_t exp = ext_pack(&hi, &lo, e, 113, -16382);
+		uint64_t bits[2] = {lo, (hi & (((uint64_t) 1 << 48) - 1)) | exp << 48};
+
+		memcpy(&result, bits, sizeof(result));
+#else
+		__float128 pow;
+
+		result = (__float128) hi * 18446744073709551616.0 + (__float128) lo;
+		pow = e < 0 ? 0.5 : 2.0;
+
+		for (unsigned n = e < 0 ? -e : e; n; n >>= 1) {
+			if (n & 1) {
+				result *= pow;
+			}
+
+			pow *= pow;
+		}
+#endif
+	}
+
+	*value = dec.sign ? -result : result;
+
+	return s;
+}
+#endif
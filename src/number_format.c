@@ -0,0 +1,568 @@
+/*
+ * Copyright (c) 2016 Simon Schoenenberger
+ * https://github.com/detomon/number_parser
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include "number_format.h"
+#include "number_internal.h"
+
+#define MANT_BITS 52
+#define INF_EXP 0x7FF
+#define MIN_EXP (-1074)
+#define MASK_63 (((uint64_t) 1 << 63) - 1)
+#define BIG_LEN 36              // number of 32-bit limbs to hold 2 ^ 1078
+#define FIXED_DIGITS (309 + 1075) // maximum number of non-zero fixed digits
+
+/**
+ * floor(q * log10(2))
+ */
+static int flog10pow2(int q) {
+	return (int) (((int64_t) q * 661971961083) >> 41);
+}
+
+/**
+ * floor(log10(3/4 * 2 ^ q))
+ */
+static int flog10three_quarters_pow2(int q) {
+	return (int) (((int64_t) q * 661971961083 - 274743187321) >> 41);
+}
+
+/**
+ * floor(e * log2(10))
+ */
+static int flog2pow10(int e) {
+	return (int) (((int64_t) e * 913124641741) >> 38);
+}
+
+/**
+ * Multiply `cp` with the 126-bit value `g1` * 2 ^ 63 + `g0` and round to odd.
+ */
+static uint64_t round_odd(uint64_t g1, uint64_t g0, uint64_t cp) {
+	uint64_t x0, y0;
+	uint64_t x1 = number_mul128(g0, cp, &x0);
+	uint64_t y1 = number_mul128(g1, cp, &y0);
+	uint64_t z = (y0 >> 1) + x1;
+	uint64_t vbp = y1 + (z >> 63);
+
+	return vbp | (((z & MASK_63) + MASK_63) >> 63);
+}
+
+static const char digit_chars[] = "0123456789abcdefghijklmnopqrstuvwxyz";
+
+static const char digit_pairs[] =
+	"00010203040506070809"
+	"10111213141516171819"
+	"20212223242526272829"
+	"30313233343536373839"
+	"40414243444546474849"
+	"50515253545556575859"
+	"60616263646566676869"
+	"70717273747576777879"
+	"80818283848586878889"
+	"90919293949596979899";
+
+static const uint64_t pow10_int[] = {
+	1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000,
+	1000000000, 10000000000, 100000000000, 1000000000000, 10000000000000,
+	100000000000000, 1000000000000000, 10000000000000000,
+	100000000000000000, 1000000000000000000, 10000000000000000000u,
+};
+
+/**
+ * Count the number of digits of `value` in `base`.
+ */
+static int count_digits(uint64_t value, int base) {
+	int bits = 64 - number_clz64(value | 1);
+
+	if (base == 10) {
+		// approximate log10 from log2 and correct with a single compare
+		int t = (bits * 1233) >> 12;
+
+		return t + ((value | 1) >= pow10_int[t]);
+	}
+	else if ((base & (base - 1)) == 0) {
+		int shift = number_ctz64(base);
+
+		return (bits + shift - 1) / shift;
+	}
+	else {
+		uint64_t limit = value / base;
+		int len = 1;
+
+		for (uint64_t p = 1; p <= limit; p *= base) {
+			len ++;
+		}
+
+		return len;
+	}
+}
+
+/**
+ * Write the `len` digits of `value` in `base` backwards starting at
+ * `buf` + `len`.
+ */
+static void write_digits_back(char* buf, uint64_t value, int base, int len) {
+	char* p = buf + len;
+
+	if (base == 10) {
+		while (value >= 100) {
+			p -= 2;
+			memcpy(p, &digit_pairs[(value % 100) * 2], 2);
+			value /= 100;
+		}
+
+		if (value >= 10) {
+			memcpy(buf, &digit_pairs[value * 2], 2);
+		}
+		else {
+			*buf = '0' + (char) value;
+		}
+	}
+	else if ((base & (base - 1)) == 0) {
+		int shift = number_ctz64(base);
+		uint64_t mask = base - 1;
+
+		while (p > buf) {
+			*-- p = digit_chars[value & mask];
+			value >>= shift;
+		}
+	}
+	else {
+		while (p > buf) {
+			*-- p = digit_chars[value % base];
+			value /= base;
+		}
+	}
+}
+
+/**
+ * Write the decimal digits of `value` and return their count.
+ */
+static int write_digits(char* buf, uint64_t value) {
+	int len = count_digits(value, 10);
+
+	write_digits_back(buf, value, 10, len);
+
+	return len;
+}
+
+/**
+ * Write `f` * 10 ^ `e` in positional or scientific notation.
+ */
+static int write_decimal(char* buf, uint64_t f, int e) {
+	char digits[20];
+	char* p = buf;
+	int len, exp;
+
+	while (f % 10 == 0) {
+		f /= 10;
+		e ++;
+	}
+
+	len = write_digits(digits, f);
+	exp = e + len - 1;
+
+	if (exp >= -4 && exp < 16) {
+		if (exp < 0) {
+			*p ++ = '0';
+			*p ++ = '.';
+
+			for (int i = -1; i > exp; i --) {
+				*p ++ = '0';
+			}
+
+			memcpy(p, digits, len);
+			p += len;
+		}
+		else if (exp >= len - 1) {
+			memcpy(p, digits, len);
+			p += len;
+
+			for (int i = len - 1; i < exp; i ++) {
+				*p ++ = '0';
+			}
+
+			*p ++ = '.';
+			*p ++ = '0';
+		}
+		else {
+			memcpy(p, digits, exp + 1);
+			p += exp + 1;
+			*p ++ = '.';
+			memcpy(p, &digits[exp + 1], len - exp - 1);
+			p += len - exp - 1;
+		}
+	}
+	else {
+		*p ++ = digits[0];
+
+		if (len > 1) {
+			*p ++ = '.';
+			memcpy(p, &digits[1], len - 1);
+			p += len - 1;
+		}
+
+		*p ++ = 'e';
+
+		if (exp < 0) {
+			*p ++ = '-';
+			exp = -exp;
+		}
+
+		p += write_digits(p, exp);
+	}
+
+	*p = '\0';
+
+	return (int) (p - buf);
+}
+
+/**
+ * Find the shortest decimal in the rounding interval of `c` * 2 ^ `q` using
+ * the Schubfach algorithm by Raffaello Giulietti.
+ */
+static int write_shortest(char* buf, int q, uint64_t c) {
+	uint64_t out = c & 1;
+	uint64_t cb = c << 2;
+	uint64_t cbr = cb + 2;
+	uint64_t cbl;
+	int k;
+
+	if (c != (uint64_t) 1 << MANT_BITS || q == MIN_EXP) {
+		cbl = cb - 2;
+		k = flog10pow2(q);
+	}
+	else {
+		cbl = cb - 1;
+		k = flog10three_quarters_pow2(q);
+	}
+
+	int h = q + flog2pow10(-k) + 2;
+
+	// derive g = floor(10 ^ -k * 2 ^ r) + 1 with 2 ^ 125 <= g < 2 ^ 126 from
+	// the truncated 128-bit power of ten
+	const uint64_t* pow = number_pow10_tab[-k - NUMBER_POW10_MIN];
+	uint64_t hi = pow[0];
+	uint64_t lo = pow[1];
+
+	if (-k >= -27 && -k < 0) {
+		hi -= lo == 0;
+		lo --;
+	}
+
+	lo = ((lo >> 2) | (hi << 62)) + 1;
+	hi = (hi >> 2) + (lo == 0);
+
+	uint64_t g1 = (hi << 1) | (lo >> 63);
+	uint64_t g0 = lo & MASK_63;
+
+	uint64_t vb = round_odd(g1, g0, cb << h);
+	uint64_t vbl = round_odd(g1, g0, cbl << h);
+	uint64_t vbr = round_odd(g1, g0, cbr << h);
+
+	uint64_t s = vb >> 2;
+
+	if (s >= 10) {
+		// s' = floor(s / 10); check if a number with one digit less is in the
+		// rounding interval
+		uint64_t sp10 = s / 10 * 10;
+		uint64_t tp10 = sp10 + 10;
+		int upin = vbl + out <= sp10 << 2;
+		int wpin = (tp10 << 2) + out <= vbr;
+
+		if (upin != wpin) {
+			return write_decimal(buf, upin ? sp10 : tp10, k);
+		}
+	}
+
+	uint64_t t = s + 1;
+	int uin = vbl + out <= s << 2;
+	int win = (t << 2) + out <= vbr;
+
+	if (uin != win) {
+		return write_decimal(buf, uin ? s : t, k);
+	}
+
+	// both are in the rounding interval; take the nearest
+	int64_t cmp = (int64_t) (vb - ((s + t) << 1));
+
+	return write_decimal(buf, cmp < 0 || (cmp == 0 && !(s & 1)) ? s : t, k);
+}
+
+int number_format_double(char* buf, double value) {
+	uint64_t bits = number_double_bits(value);
+	uint64_t t = bits & (((uint64_t) 1 << MANT_BITS) - 1);
+	int bq = (int) (bits >> MANT_BITS) & INF_EXP;
+	char* p = buf;
+
+	if (bq == INF_EXP) {
+		if (t) {
+			memcpy(buf, "nan", 4);
+			return 3;
+		}
+	}
+
+	if (bits >> 63) {
+		*p ++ = '-';
+	}
+
+	if (bq == INF_EXP) {
+		memcpy(p, "inf", 4);
+		return (int) (p - buf) + 3;
+	}
+
+	if (bq != 0) {
+		int mq = -MIN_EXP + 1 - bq;
+		uint64_t c = ((uint64_t) 1 << MANT_BITS) | t;
+
+		// integers are exact
+		if (mq > 0 && mq <= MANT_BITS) {
+			uint64_t f = c >> mq;
+
+			if (f << mq == c) {
+				return (int) (p - buf) + write_decimal(p, f, 0);
+			}
+		}
+
+		return (int) (p - buf) + write_shortest(p, -mq, c);
+	}
+
+	if (t) {
+		return (int) (p - buf) + write_shortest(p, MIN_EXP, t);
+	}
+
+	memcpy(p, "0.0", 4);
+
+	return (int) (p - buf) + 3;
+}
+
+/**
+ * Multiply big integer `big` with `len` limbs by `mul` and return the carry.
+ */
+static uint32_t big_mul(uint32_t* big, int len, uint32_t mul) {
+	uint64_t carry = 0;
+
+	for (int i = 0; i < len; i ++) {
+		carry += (uint64_t) big[i] * mul;
+		big[i] = (uint32_t) carry;
+		carry >>= 32;
+	}
+
+	return (uint32_t) carry;
+}
+
+/**
+ * Divide big integer `big` with `len` limbs by `div` and return the remainder.
+ */
+static uint32_t big_div(uint32_t* big, int len, uint32_t div) {
+	uint64_t rem = 0;
+
+	for (int i = len - 1; i >= 0; i --) {
+		rem = (rem << 32) | big[i];
+		big[i] = (uint32_t) (rem / div);
+		rem %= div;
+	}
+
+	return (uint32_t) rem;
+}
+
+/**
+ * Write the decimal digits of big integer `big` with `len` limbs.
+ */
+static int big_write_digits(char* buf, uint32_t* big, int len) {
+	char tmp[320];
+	int n = 0;
+
+	do {
+		uint32_t chunk = big_div(big, len, 1000000000);
+
+		while (len > 0 && big[len - 1] == 0) {
+			len --;
+		}
+
+		for (int i = 0; i < 9 && (chunk || len); i ++) {
+			tmp[n ++] = '0' + chunk % 10;
+			chunk /= 10;
+		}
+	}
+	while (len);
+
+	for (int i = 0; i < n; i ++) {
+		buf[i] = tmp[n - i - 1];
+	}
+
+	return n;
+}
+
+int number_format_double_fixed(char* buf, size_t size, double value, int precision) {
+	uint64_t bits = number_double_bits(value);
+	uint64_t m = bits & (((uint64_t) 1 << MANT_BITS) - 1);
+	int bq = (int) (bits >> MANT_BITS) & INF_EXP;
+	uint32_t big[BIG_LEN] = {0};
+	char digits[FIXED_DIGITS + 1];
+	int int_len, frac_len = 0, len = 0, e;
+	int round_up = 0;
+
+	if (precision < 0) {
+		precision = 0;
+	}
+
+	if (bq == INF_EXP) {
+		const char* str = m ? "nan" : bits >> 63 ? "-inf" : "inf";
+		int n = (int) strlen(str);
+
+		if (size) {
+			size_t c = (size_t) n < size - 1 ? (size_t) n : size - 1;
+
+			memcpy(buf, str, c);
+			buf[c] = '\0';
+		}
+
+		return n;
+	}
+
+	if (bq) {
+		m |= (uint64_t) 1 << MANT_BITS;
+		e = bq - 1075;
+	}
+	else {
+		e = MIN_EXP;
+	}
+
+	// split into integer part and fraction with `-e` bits
+	if (e >= 0) {
+		int word = e / 32, shift = e % 32;
+		uint64_t lo = m << shift, hi = shift ? m >> (64 - shift) : 0;
+
+		big[word] = (uint32_t) lo;
+		big[word + 1] = (uint32_t) (lo >> 32);
+		big[word + 2] = (uint32_t) hi;
+		int_len = big_write_digits(digits, big, word + 3);
+		e = 0;
+	}
+	else {
+		int_len = write_digits(digits, -e < 64 ? m >> -e : 0);
+
+		if (-e < 64) {
+			m &= ((uint64_t) 1 << -e) - 1;
+		}
+
+		big[0] = (uint32_t) m;
+		big[1] = (uint32_t) (m >> 32);
+		e = -e;
+	}
+
+	// generate fractional digits by multiplying the fraction by 10 and
+	// extracting the bits above the fraction
+	int word = e / 32, shift = e % 32;
+	uint32_t mask = ((uint32_t) 1 << shift) - 1;
+	int nonzero = e > 0 && (big[0] | big[1]);
+
+	while (frac_len < precision && nonzero) {
+		big_mul(big, word + 2, 10);
+		digits[int_len + frac_len ++] = '0' + (int) ((((uint64_t) big[word + 1] << 32) | big[word]) >> shift);
+		big[word] &= mask;
+		big[word + 1] = 0;
+		nonzero = 0;
+
+		for (int i = 0; i <= word; i ++) {
+			nonzero |= big[i] != 0;
+		}
+	}
+
+	// round the remaining fraction to nearest, ties to even
+	if (nonzero) {
+		int cmp = 0;
+		uint32_t half = (uint32_t) 1 << ((e - 1) % 32);
+		int half_word = (e - 1) / 32;
+
+		for (int i = word; i >= 0 && !cmp; i --) {
+			uint32_t h = i == half_word ? half : 0;
+
+			cmp = (big[i] > h) - (big[i] < h);
+		}
+
+		round_up = cmp > 0 || (cmp == 0 && (digits[int_len + frac_len - 1] & 1));
+	}
+
+	if (round_up) {
+		int i = int_len + frac_len - 1;
+
+		while (i >= 0 && digits[i] == '9') {
+			digits[i --] = '0';
+		}
+
+		if (i >= 0) {
+			digits[i] ++;
+		}
+		else {
+			memmove(&digits[1], digits, int_len + frac_len);
+			digits[0] = '1';
+			int_len ++;
+		}
+	}
+
+	// write sign, digits and padding
+	#define PUT(c) do { if ((size_t) len + 1 < size) { buf[len] = (c); } len ++; } while (0)
+
+	if (bits >> 63) {
+		PUT('-');
+	}
+
+	for (int i = 0; i < int_len; i ++) {
+		PUT(digits[i]);
+	}
+
+	if (precision) {
+		PUT('.');
+
+		for (int i = 0; i < precision; i ++) {
+			PUT(i < frac_len ? digits[int_len + i] : '0');
+		}
+	}
+
+	#undef PUT
+
+	if (size) {
+		buf[(size_t) len < size ? (size_t) len : size - 1] = '\0';
+	}
+
+	return len;
+}
+
+int number_format_uint(char* buf, uint64_t value, int base) {
+	int len = count_digits(value, base);
+
+	write_digits_back(buf, value, base, len);
+	buf[len] = '\0';
+
+	return len;
+}
+
+int number_format_int(char* buf, int64_t value, int base) {
+	if (value < 0) {
+		*buf = '-';
+
+		return number_format_uint(buf + 1, -(uint64_t) value, base) + 1;
+	}
+
+	return number_format_uint(buf, value, base);
+}
@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2016 Simon Schoenenberger
+ * https://github.com/detomon/number_parser
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+/**
+ * @file
+ *
+ * Number formatter complementing the number parser.
+ *
+ * number_format_double() writes the shortest decimal representation of a
+ * `double` which is parsed back to exactly the same value by the number parser
+ * with base 10. number_format_double_fixed() writes a `double` with a fixed
+ * number of fractional digits. number_format_int() and number_format_uint()
+ * write integers in any base between 2 and 36.
+ *
+ * @code{.c}
+ * char buf[NUMBER_FORMAT_DOUBLE_SIZE];
+ *
+ * number_format_double(buf, 0.3);   // "0.3"
+ * number_format_double(buf, 1e100); // "1e100"
+ * number_format_double(buf, 5.0);   // "5.0"
+ *
+ * char fixed[32];
+ *
+ * number_format_double_fixed(fixed, sizeof(fixed), 2.675, 2); // "2.67"
+ *
+ * char id[NUMBER_FORMAT_INT_SIZE];
+ *
+ * number_format_int(id, -255, 16); // "-ff"
+ * @endcode
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define NUMBER_FORMAT_DOUBLE_SIZE 32 ///< The buffer size needed by number_format_double().
+#define NUMBER_FORMAT_INT_SIZE 66    ///< The buffer size needed by number_format_int() and number_format_uint().
+
+/**
+ * Write the shortest decimal representation of `value` which round-trips
+ * through the number parser.
+ *
+ * Numbers with a decimal exponent between -4 and 15 are written in positional
+ * notation and always contain a radix point, so they are parsed as
+ * floating-point values. Other numbers are written in scientific notation,
+ * for example `1.5e-7`. Non-finite values are written as `inf`, `-inf` and
+ * `nan`.
+ *
+ * @param buf The output buffer of size `NUMBER_FORMAT_DOUBLE_SIZE`.
+ * @param value The value to format.
+ * @return The number of characters written, excluding the terminating null
+ * character.
+ */
+extern int number_format_double(char* buf, double value);
+
+/**
+ * Write `value` with exactly `precision` fractional digits.
+ *
+ * The value is rounded correctly to the nearest representation with ties
+ * rounded to even. Like `snprintf`, at most `size` - 1 characters are written
+ * and the output is null terminated if `size` is not 0.
+ *
+ * @param buf The output buffer.
+ * @param size The size of the output buffer.
+ * @param value The value to format.
+ * @param precision The number of fractional digits.
+ * @return The number of characters which would have been written if `size`
+ * had been sufficiently large, excluding the terminating null character.
+ */
+extern int number_format_double_fixed(char* buf, size_t size, double value, int precision);
+
+/**
+ * Write `value` in `base` using the digits `0-9` and `a-z`.
+ *
+ * The digits are written backwards into `buf`, so no intermediate buffer is
+ * needed. Power-of-two bases are written without divisions.
+ *
+ * @param buf The output buffer of size `NUMBER_FORMAT_INT_SIZE`.
+ * @param value The value to format.
+ * @param base The number base between 2 and 36.
+ * @return The number of characters written, excluding the terminating null
+ * character.
+ */
+extern int number_format_uint(char* buf, uint64_t value, int base);
+
+/**
+ * Write `value` in `base` using the digits `0-9` and `a-z`. Negative values
+ * are prefixed with `-`.
+ *
+ * @param buf The output buffer of size `NUMBER_FORMAT_INT_SIZE`.
+ * @param value The value to format.
+ * @param base The number base between 2 and 36.
+ * @return The number of characters written, excluding the terminating null
+ * character.
+ */
+extern int number_format_int(char* buf, int64_t value, int base);
+
+#ifdef __cplusplus
+}
+#endif
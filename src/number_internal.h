@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2016 Simon Schoenenberger
+ * https://github.com/detomon/number_parser
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+/**
+ * @file
+ *
+ * Internal helpers shared by the parser and the formatter. The conversion
+ * helpers which number_parser.hpp uses as well are in number_core.h.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+#include "number_core.h"
+
+/**
+ * The default digit table of `number_bases`, which maps `0-9` and `a-z` or
+ * `A-Z` to the values 0 to 35 and all other characters to 0xFF. Descriptors
+ * using it have `digits` equal to this pointer.
+ */
+extern const uint8_t* const number_digit_values;
+
+/**
+ * Calculate the exact value of the 128-bit mantissa `w` * 10 ^ `q` rounded to
+ * odd with 128 bits. `sticky` marks nonzero digits dropped after `w`, which
+ * make the value slightly larger. The result is normalized so that bit 127 of
+ * `hi`:`lo` is set. Returns the exponent of bit 127. `w` must not be 0.
+ */
+extern int number_wide_to_odd128(const uint64_t w[2], int q, int sticky, uint64_t* hi, uint64_t* lo);
+
+/**
+ * Get the magnitude of the decimal number at the beginning of the string from
+ * `str` to `end` correctly rounded to `double` for any number of digits. The
+ * number is scanned like by number_parser_scan() with `flags`.
+ */
+extern double number_ext_decimal_to_double(const char* str, const char* end, int flags);
+
+/**
+ * Calculate `a` * `b` + `c` and store the result in `r`.
+ * Returns 1 if the result overflows 64 bits or is greater than `max`.
+ */
+static inline int number_mul_add_overflow(uint64_t a, uint64_t b, uint64_t c, uint64_t max, uint64_t* r) {
+#if defined(__GNUC__)
+	int overflow = __builtin_mul_overflow(a, b, r);
+
+	overflow |= __builtin_add_overflow(*r, c, r);
+
+	return overflow | (*r > max);
+#else
+	uint64_t lo;
+	uint64_t hi = number_mul128(a, b, &lo);
+
+	*r = lo + c;
+
+	return hi || c > max || lo > max - c;
+#endif
+}
@@ -22,28 +22,267 @@
  */
 
 #include "number_parser.h"
+#include "number_internal.h"
+#include "number_simd.h"
 
 #define MAX_INT ((uint64_t) INT64_MAX + 1)
 #define MAX_POS_INT (MAX_INT - 1)
-#define MAX_EXP (-DBL_MIN_10_EXP)
+#define MAX_EXP (1 << 22) // larger exponents overflow or underflow any mantissa
 #define MAX_LEN INT16_MAX
+#define MANT_BITS 52
+#define INF_EXP 0x7FF
+#define MAX_POW10 308 // larger powers of ten always overflow
+#define WIDE_MAX_HI (UINT64_MAX / 10) // `wide` has room for another decimal digit below this high word
 
 static void convert_to_float(number_parser* parser, int was_int) {
 	if (!parser->is_float) {
+		// overflowed mantissas are kept exactly while they fit into 128 bits
+		if (was_int) {
+			parser->is_wide = 1;
+			parser->wide[0] = parser->uval;
+			parser->wide[1] = 0;
+		}
+
 		parser->is_float = 1;
 		parser->was_int = was_int;
 		parser->fval = parser->uval;
 	}
 }
 
-void number_parser_add_digit(number_parser* parser, int digit) {
+/**
+ * Multiply the 128-bit mantissa by `mul`, which is `base` ^ `len`, and add the
+ * `len` digits of `add`. After the mantissa is full, digits are dropped; only
+ * the number of dropped integer digits and whether any of them was nonzero is
+ * recorded.
+ *
+ * Returns the number of digits added to the mantissa or -1 if only some of
+ * the digits would fit, so they have to be added one by one.
+ */
+static int add_wide(number_parser* parser, uint64_t mul, uint64_t add, int len) {
+	uint64_t lo0, lo1, hi0, hi1;
+	uint64_t max_hi = parser->base == 10 ? WIDE_MAX_HI : UINT64_MAX / parser->base;
+
+	if (!parser->is_wide) {
+		return len;
+	}
+
+	// once there is no room for another digit, the mantissa is not changed
+	// anymore
+	if (parser->wide[1] >= max_hi) {
+		parser->is_sticky |= add != 0;
+		parser->round_up = 0;
+
+		if (parser->rad_off < 0) {
+			parser->wide_drop = parser->wide_drop > MAX_LEN - len ? MAX_LEN : parser->wide_drop + len;
+		}
+
+		return 0;
+	}
+
+	hi0 = number_mul128(parser->wide[0], mul, &lo0);
+	hi1 = number_mul128(parser->wide[1], mul, &lo1);
+	lo0 += add;
+	hi0 += lo0 < add;
+	lo1 += hi0;
+	hi1 += lo1 < hi0;
+
+	// the mantissa before the last digit has to have room for it like when
+	// adding digits one by one
+	if (hi1 || lo1 >= max_hi * parser->base) {
+		return -1;
+	}
+
+	parser->wide[0] = lo0;
+	parser->wide[1] = lo1;
+
+	return len;
+}
+
+/**
+ * Calculate `w` * 10 ^ `q` rounded to odd with 63 bits. The result is
+ * normalized so that bit 63 is set and bit 0 is set if any lower bit is set.
+ * The exponent of bit 63 is stored in `e`.
+ *
+ * Rounding the result once more to 61 bits or less is the same as rounding
+ * the exact value once.
+ */
+static uint64_t decimal_to_odd(uint64_t w, int q, int* e) {
+	static const uint64_t pows_5[] = {
+		1, 5, 25, 125, 625, 3125, 15625, 78125, 390625, 1953125, 9765625,
+		48828125, 244140625, 1220703125, 6103515625, 30517578125,
+		152587890625, 762939453125, 3814697265625, 19073486328125,
+		95367431640625, 476837158203125, 2384185791015625,
+		11920928955078125, 59604644775390625, 298023223876953125,
+		1490116119384765625, 7450580596923828125,
+	};
+	uint64_t lo, hi, lo2, hi2, sticky;
+	int lz, upper;
+
+	// exact binary fractions
+	if (q < 0 && q > -(int) (sizeof(pows_5) / sizeof(*pows_5)) && w % pows_5[-q] == 0) {
+		w /= pows_5[-q];
+		lz = number_clz64(w);
+		*e = 63 - lz + q;
+
+		return w << lz;
+	}
+
+	lz = number_clz64(w);
+	w <<= lz;
+
+	const uint64_t* pow = number_pow10_tab[q - NUMBER_POW10_MIN];
+
+	// 192-bit product `hi`:`lo`:`lo2`
+	hi = number_mul128(w, pow[0], &lo);
+	hi2 = number_mul128(w, pow[1], &lo2);
+	lo += hi2;
+	hi += lo < hi2;
+
+	upper = (int) (hi >> 63);
+	*e = ((217706 * q) >> 16) + 63 + upper - lz;
+
+	if (!upper) {
+		hi = (hi << 1) | (lo >> 63);
+		lo <<= 1;
+	}
+
+	// the product is only exact for powers of ten between 0 and 55; other
+	// values have an odd factor greater than 2 ^ 63
+	sticky = lo | lo2 | (hi & 1) | (q < 0 || q > 55);
+
+	return (hi & ~(uint64_t) 1) | (sticky != 0);
+}
+
+/**
+ * Round the parser's value to a 16-bit binary format like
+ * number_round_binary(). The value is only rounded once if the base is 10 or a
+ * power of two, also if the mantissa has overflowed into `wide`; otherwise,
+ * the parser is terminated and its `double` value is rounded.
+ */
+static uint16_t parser_to_binary16(number_parser* parser, int mant_bits, int bias) {
+	uint32_t sign = (uint32_t) parser->sign << 15;
+	uint32_t inf = (uint32_t) (bias * 2 + 1) << mant_bits;
+	uint64_t w = parser->uval;
+	uint64_t r;
+	int n = parser->exp_sign ? -parser->exp_val : parser->exp_val;
+	int base = parser->base;
+	int e, lz;
+
+	if (parser->rad_off >= 0) {
+		n -= parser->int_len - parser->rad_off;
+	}
+	else {
+		n += parser->zero_len;
+	}
+
+	if ((!parser->is_float || parser->is_wide) && (base == 10 || (base & (base - 1)) == 0)) {
+		int is_wide = parser->is_float;
+
+		if (is_wide) {
+			n += parser->wide_drop;
+		}
+		else if (w == 0) {
+			return (uint16_t) sign;
+		}
+
+		if (base == 10) {
+			if (n < NUMBER_POW10_MIN) {
+				return (uint16_t) sign;
+			}
+			else if (n > MAX_POW10) {
+				return (uint16_t) (sign | inf);
+			}
+
+			if (is_wide) {
+				uint64_t lo;
+
+				// the dropped digits only count as nonzero, like in end()
+				e = number_wide_to_odd128(parser->wide, n, parser->is_sticky, &r, &lo);
+				r |= lo != 0;
+			}
+			else {
+				r = decimal_to_odd(w, n, &e);
+			}
+		}
+		else {
+			long exp;
+
+			if (is_wide) {
+				r = number_wide_mant(parser->wide, parser->is_sticky, &e);
+			}
+			else {
+				lz = number_clz64(w);
+				r = w << lz;
+				e = 63 - lz;
+			}
+
+			exp = (long) n * number_ctz64(base) + e;
+
+			// saturate; larger exponents overflow anyway
+			exp = exp < -(1 << 14) ? -(1 << 14) : exp > (1 << 14) ? (1 << 14) : exp;
+			e = (int) exp;
+		}
+	}
+	else {
+		uint64_t bits;
+
+		number_parser_end(parser);
+		bits = number_double_bits(parser->fval) & ~((uint64_t) 1 << 63);
+
+		if (bits >= (uint64_t) INF_EXP << MANT_BITS) {
+			return (uint16_t) (sign | inf);
+		}
+		else if (bits == 0) {
+			return (uint16_t) sign;
+		}
+
+		e = (int) (bits >> MANT_BITS);
+		r = bits & (((uint64_t) 1 << MANT_BITS) - 1);
+
+		// subnormal numbers have no hidden bit
+		if (e) {
+			r |= (uint64_t) 1 << MANT_BITS;
+		}
+		else {
+			e = 1;
+		}
+
+		lz = number_clz64(r);
+		e += -1023 + 63 - MANT_BITS - lz;
+		r <<= lz;
+	}
+
+	return (uint16_t) (sign | number_round_binary(r, e, mant_bits, bias));
+}
+
+/**
+ * Count `len` zeros in `zero_len` without adding them to the mantissa.
+ */
+static void count_zeros(number_parser* parser, int len) {
+	int max = MAX_LEN - parser->int_len;
+
+	parser->zero_len = parser->zero_len > max - len ? max : parser->zero_len + len;
+	parser->round_up = 0;
+}
+
+/**
+ * Add `digit` to the mantissa.
+ */
+static void add_mant_digit(number_parser* parser, int digit) {
+	// fewer digits than `safe_len` cannot overflow the mantissa
+	if (parser->int_len < parser->desc->safe_len) {
+		parser->uval = parser->uval * parser->base + digit;
+		parser->int_len ++;
+		return;
+	}
+
 	if (parser->int_len >= MAX_LEN) {
 		return;
 	}
 
 	if (!parser->is_float) {
 		// check if there is room for another digit, otherwise convert to float
-		if (parser->uval > MAX_INT / parser->base) {
+		if (parser->uval > parser->desc->max_mul) {
 			convert_to_float(parser, 1);
 		}
 	}
@@ -55,80 +294,785 @@ void number_parser_add_digit(number_parser* parser, int digit) {
 		// representable negative value
 		if (parser->uval > MAX_INT - digit) {
 			convert_to_float(parser, 1);
-			parser->fval += digit;
+			add_wide(parser, 1, digit, 1);
 		}
 		else {
 			parser->uval += digit;
 		}
 	}
 	else {
-		parser->fval = parser->fval * parser->base + digit;
+		// an overflowed mantissa is only kept in `wide`
+		parser->int_len += add_wide(parser, parser->base, digit, 1);
+		return;
 	}
 
 	parser->int_len ++;
 }
 
+/**
+ * Add the zeros counted in `zero_len` to the mantissa.
+ */
+static void add_zeros(number_parser* parser) {
+	int len = parser->zero_len;
+
+	parser->zero_len = 0;
+
+	// leading zeros only move the fraction digits
+	if (!parser->is_float && !parser->uval) {
+		if (parser->rad_off >= 0) {
+			parser->int_len += len;
+		}
+
+		return;
+	}
+
+	for (; len > 0; len --) {
+		add_mant_digit(parser, 0);
+	}
+}
+
+void number_parser_add_digit(number_parser* parser, int digit) {
+	// zeros are only counted until a nonzero digit follows like in
+	// number_parser_add_digits(), so both round the same
+	if (!digit) {
+		count_zeros(parser, 1);
+		return;
+	}
+
+	if (parser->zero_len) {
+		add_zeros(parser);
+	}
+
+	add_mant_digit(parser, digit);
+}
+
 void number_parser_add_exp_digit(number_parser* parser, int digit) {
 	// ignore large exponent values
 	if (parser->exp_val < MAX_EXP) {
 		parser->exp_val = parser->exp_val * parser->base + digit;
 		parser->has_exp = 1;
 	}
+
+	parser->round_up = 0;
 }
 
-int number_parser_end(number_parser* parser) {
-	// As the maximum magnitude of a positive integer is one less than its
-	// negative counterpart, it cannot be represented as a signed integer if
-	// its value is greater or equal as such. So convert to a floating-point
-	// value. Also convert if an exponent or the radix point is set.
-	if ((!parser->sign && parser->uval > MAX_POS_INT)) {
-		convert_to_float(parser, 1);
+/**
+ * Merge the value `chunk` of `len` digits into the mantissa with a single
+ * multiply-add, where `mul` is `base` ^ `len`.
+ *
+ * Returns 0 if the integer or 128-bit mantissa would overflow, so the digits
+ * have to be added one by one to convert at the right digit.
+ */
+static int add_chunk(number_parser* parser, uint64_t chunk, int len, uint64_t mul) {
+	if (parser->int_len > MAX_LEN - len) {
+		return 0;
 	}
 
-	if (parser->has_exp || parser->rad_off >= 0) {
-		convert_to_float(parser, 0);
+	if (!parser->is_float) {
+		// fewer digits than `safe_len` cannot overflow the mantissa
+		if (parser->int_len + len <= parser->desc->safe_len) {
+			parser->uval = parser->uval * mul + chunk;
+		}
+		else {
+			uint64_t lo;
+			uint64_t hi = number_mul128(parser->uval, mul, &lo);
+
+			if (hi || lo > MAX_INT - chunk) {
+				return 0;
+			}
+
+			parser->uval = lo + chunk;
+		}
 	}
+	else {
+		int added = add_wide(parser, mul, chunk, len);
 
-	if (parser->is_float) {
-		int n = parser->exp_val;
-		double d = parser->base;
-		double e = 1.0;
+		if (added < 0) {
+			return 0;
+		}
+
+		parser->int_len += added;
+		return 1;
+	}
 
-		if (parser->exp_sign) {
-			n = -n;
+	parser->int_len += len;
+
+	return 1;
+}
+
+#ifdef NUMBER_SIMD_POW2
+/**
+ * Add blocks of up to 16 digits in base 2, 8 or 16 converted with the SIMD
+ * kernels to the integer mantissa. Returns a pointer to the first character not
+ * consumed, which is left to the scalar path if the mantissa would overflow.
+ */
+static const char* add_pow2_digits(number_parser* parser, const char* str, const char* end) {
+	uint8_t base = parser->base;
+	int bits = base == 16 ? 4 : base == 8 ? 3 : 1;
+
+	while (end - str >= 16 && !parser->is_float) {
+		uint64_t value;
+		uint64_t uval = parser->uval;
+		int len = base == 16 ? number_simd_hex16(str, &value) : base == 8 ? number_simd_oct16(str, &value) : number_simd_bin16(str, &value);
+		int shift = len * bits;
+
+		if (!len || parser->int_len > MAX_LEN - len) {
+			break;
 		}
 
-		if (parser->rad_off >= 0) {
-			n -= parser->int_len - parser->rad_off;
+		// multiplying by `base` ^ `len` must not shift out any bits
+		if (shift < 64 ? uval >> (64 - shift) : uval) {
+			break;
 		}
 
-		if (n < 0) {
-			parser->exp_sign = 1;
-			n = -n;
+		uval = (shift < 64 ? uval << shift : 0) | value;
+
+		if (uval > MAX_INT) {
+			break;
+		}
+
+		parser->uval = uval;
+		parser->int_len += len;
+		str += len;
+
+		if (len < 16) {
+			break;
 		}
+	}
 
-		while (n) {
-			if (n & 1) {
-				e *= d;
+	return str;
+}
+#endif
+
+/**
+ * Returns a pointer to the first character from `str` to `end` which is not
+ * `0`.
+ */
+static const char* skip_zeros(const char* str, const char* end) {
+#ifdef NUMBER_SIMD_ZEROS
+	while (end - str >= 16) {
+		int len = number_simd_zeros16(str);
+
+		str += len;
+
+		if (len < 16) {
+			return str;
+		}
+	}
+#else
+	uint64_t word;
+
+	while (end - str >= 8 && (memcpy(&word, str, 8), word == 0x3030303030303030)) {
+		str += 8;
+	}
+#endif
+
+	while (str < end && *str == '0') {
+		str ++;
+	}
+
+	return str;
+}
+
+const char* number_parser_add_digits(number_parser* parser, const char* str, const char* end) {
+	const number_base* desc = parser->desc;
+	const uint8_t* digits = desc->digits;
+	uint8_t base = desc->base;
+	int len = desc->chunk_len;
+
+	// leading zeros are only counted
+	if (str < end && *str == '0' && !parser->is_float && !parser->uval && digits['0'] == 0) {
+		const char* s = skip_zeros(str, end);
+
+		count_zeros(parser, (int) (s - str < MAX_LEN ? s - str : MAX_LEN));
+		str = s;
+	}
+
+#ifdef NUMBER_SIMD_POW2
+	if ((base == 16 || base == 8 || base == 2) && digits == number_digit_values) {
+		if (parser->zero_len) {
+			add_zeros(parser);
+		}
+
+		str = add_pow2_digits(parser, str, end);
+	}
+#endif
+
+	// combine `chunk_len` digits in a local value, which cannot overflow
+	while (end - str >= len) {
+		uint64_t chunk = 0, mul = desc->chunk_mul;
+		int i, nz_len = len;
+
+		for (i = 0; i < len; i ++) {
+			int digit = digits[(uint8_t) str[i]];
+
+			if (digit >= base) {
+				break;
 			}
 
-			n >>= 1;
-			d *= d;
+			chunk = chunk * base + digit;
 		}
 
-		if (parser->sign) {
-			parser->fval = -parser->fval;
+		if (i < len) {
+			break;
 		}
 
-		if (parser->exp_sign) {
-			parser->fval /= e;
+		if (!chunk) {
+			count_zeros(parser, len);
+			str += len;
+			continue;
 		}
-		else {
-			parser->fval *= e;
+
+		if (parser->zero_len) {
+			add_zeros(parser);
+		}
+
+		// trailing zeros of the block are only counted like zeros at the end
+		// of the number
+		while (!digits[(uint8_t) str[nz_len - 1]]) {
+			chunk /= base;
+			mul /= base;
+			nz_len --;
+		}
+
+		// add the digits one by one to convert at the right digit
+		if (!add_chunk(parser, chunk, nz_len, mul)) {
+			for (i = 0; i < nz_len; i ++) {
+				add_mant_digit(parser, digits[(uint8_t) str[i]]);
+			}
+		}
+
+		count_zeros(parser, len - nz_len);
+		str += len;
+	}
+
+	// fewer than `len` digits are left, so they are combined like a block;
+	// only the digits up to the last nonzero one are added to the mantissa
+	uint64_t chunk = 0, mul = 1, nz_chunk = 0, nz_mul = 1;
+	int i, nz_len = 0;
+
+	for (i = 0; str + i < end; i ++) {
+		int digit = digits[(uint8_t) str[i]];
+
+		if (digit >= base) {
+			break;
+		}
+
+		chunk = chunk * base + digit;
+		mul *= base;
+
+		if (digit) {
+			nz_chunk = chunk;
+			nz_mul = mul;
+			nz_len = i + 1;
+		}
+	}
+
+	if (nz_len) {
+		if (parser->zero_len) {
+			add_zeros(parser);
+		}
+
+		if (!add_chunk(parser, nz_chunk, nz_len, nz_mul)) {
+			for (int j = 0; j < nz_len; j ++) {
+				add_mant_digit(parser, digits[(uint8_t) str[j]]);
+			}
+		}
+	}
+
+	count_zeros(parser, i - nz_len);
+
+	return str + i;
+}
+
+/**
+ * Decide the rounding of a decimal number whose digits dropped from `wide` are
+ * only known to be nonzero. If a halfway point between two doubles lies between
+ * the kept mantissa and its successor, the number from `str` to `end` is
+ * rounded exactly with number_ext_decimal_to_double(). `round_up` is set if the
+ * result is the upper double, so number_parser_end() rounds to it. The
+ * mantissa itself is not changed.
+ */
+static void round_dropped(number_parser* parser, const char* str, const char* end, int flags) {
+	uint64_t next[2] = {parser->wide[0] + 1, parser->wide[1] + (parser->wide[0] == UINT64_MAX)};
+	int n = parser->exp_sign ? -parser->exp_val : parser->exp_val;
+	double lower;
+
+	if (parser->rad_off >= 0) {
+		n -= parser->int_len - parser->rad_off;
+	}
+	else {
+		n += parser->zero_len;
+	}
+
+	n += parser->wide_drop;
+	lower = number_wide_decimal_to_double(parser->wide, n, 1, 0);
+
+	if (lower != number_wide_decimal_to_double(next, n, 0, 0) && number_ext_decimal_to_double(str, end, flags) > lower) {
+		parser->round_up = 1;
+	}
+}
+
+const char* number_parser_scan(number_parser* parser, const char* str, const char* end, int flags) {
+	const char* s = str;
+	const char* digits;
+	int has_digits, has_exp = 0;
+	int is_new = !parser->int_len && !parser->zero_len && !parser->is_float && parser->rad_off < 0 && !parser->has_exp;
+
+	if ((flags & NUMBER_PARSER_SCAN_SIGN) && s < end && *s == '-') {
+		number_parser_set_neg(parser, 1);
+		s ++;
+	}
+
+	digits = s;
+	s = number_parser_add_digits(parser, s, end);
+	has_digits = s > digits;
+
+	if ((flags & NUMBER_PARSER_SCAN_RAD_POINT) && s < end && *s == '.') {
+		// a radix point needs at least one integer or fractional digit
+		if (has_digits || (s + 1 < end && parser->desc->digits[(uint8_t) s[1]] < parser->base)) {
+			number_parser_set_rad_point(parser);
+			s = number_parser_add_digits(parser, s + 1, end);
+			has_digits = 1;
+		}
+	}
+
+	if (!has_digits) {
+		return str;
+	}
+
+	// 'e' is a digit in bases greater than 14
+	if ((flags & (NUMBER_PARSER_SCAN_EXP | NUMBER_PARSER_SCAN_EXP_REQUIRED)) && parser->base <= 10 && s < end && (*s | 0x20) == 'e') {
+		const char* e = s + 1;
+		int negative = 0;
+
+		if (e < end && (*e == '-' || *e == '+')) {
+			negative = *e == '-';
+			e ++;
+		}
+
+		digits = e;
+
+		for (; e < end && parser->desc->digits[(uint8_t) *e] < parser->base; e ++) {
+			number_parser_add_exp_digit(parser, parser->desc->digits[(uint8_t) *e]);
+		}
+
+		if (e > digits) {
+			number_parser_set_exp_neg(parser, negative);
+			s = e;
+			has_exp = 1;
+		}
+	}
+
+	if ((flags & NUMBER_PARSER_SCAN_EXP_REQUIRED) && !has_exp) {
+		return str;
+	}
+
+	// the whole number is known, so dropped digits can be compared exactly
+	if (parser->is_sticky && is_new && parser->base == 10 && parser->desc->digits == number_digit_values) {
+		round_dropped(parser, str, s, flags);
+	}
+
+	return s;
+}
+
+/**
+ * Scan the digits of the string from `str` to `end` into `value` and check
+ * that the value is not greater than `max`. Combines blocks of `chunk_len`
+ * digits like number_parser_add_digits().
+ *
+ * Returns the number of consumed characters, which is 0 if there are no
+ * digits. `overflow` is set to 1 if the value is greater than `max`.
+ */
+static size_t scan_uint(const number_base* desc, const char* str, const char* end, uint64_t max, uint64_t* value, int* overflow) {
+	const uint8_t* digits = desc->digits;
+	const char* s = str;
+	uint8_t base = desc->base;
+	int len = desc->chunk_len;
+	uint64_t val = 0;
+
+	*overflow = 0;
+
+	while (end - s >= len) {
+		uint64_t chunk = 0;
+		int i;
+
+		for (i = 0; i < len; i ++) {
+			int digit = digits[(uint8_t) s[i]];
+
+			if (digit >= base) {
+				break;
+			}
+
+			chunk = chunk * base + digit;
+		}
+
+		if (i < len) {
+			break;
+		}
+
+		*overflow |= number_mul_add_overflow(val, desc->chunk_mul, chunk, max, &val);
+		s += len;
+	}
+
+	for (; s < end; s ++) {
+		int digit = digits[(uint8_t) *s];
+
+		if (digit >= base) {
+			break;
+		}
+
+		*overflow |= number_mul_add_overflow(val, base, digit, max, &val);
+	}
+
+	*value = val;
+
+	return s - str;
+}
+
+int number_parser_scan_int(const number_base* desc, const char** str, const char* end, int flags, int64_t* value) {
+	const char* s = *str;
+	int negative = 0;
+	int overflow;
+	uint64_t val;
+	size_t len;
+
+	if ((flags & NUMBER_PARSER_SCAN_SIGN) && s < end && *s == '-') {
+		negative = 1;
+		s ++;
+	}
+
+	len = scan_uint(desc, s, end, negative ? MAX_INT : MAX_POS_INT, &val, &overflow);
+
+	if (!len) {
+		return NUMBER_PARSER_ERR_INVALID;
+	}
+
+	*str = s + len;
+
+	if (overflow) {
+		return NUMBER_PARSER_ERR_RANGE;
+	}
+
+	*value = (int64_t) (negative ? 0 - val : val);
+
+	return NUMBER_PARSER_OK;
+}
+
+int number_parser_scan_uint(const number_base* desc, const char** str, const char* end, uint64_t* value) {
+	int overflow;
+	uint64_t val;
+	size_t len = scan_uint(desc, *str, end, UINT64_MAX, &val, &overflow);
+
+	if (!len) {
+		return NUMBER_PARSER_ERR_INVALID;
+	}
+
+	*str += len;
+
+	if (overflow) {
+		return NUMBER_PARSER_ERR_RANGE;
+	}
+
+	*value = val;
+
+	return NUMBER_PARSER_OK;
+}
+
+/**
+ * Scan an integer whose magnitude is at most `max` if positive or `min` if
+ * negative, which are both less than `base` ^ (`safe_len` - 1). The magnitude
+ * is stored in `value` and the sign in `negative`.
+ */
+static int scan_narrow(const number_base* desc, const char** str, const char* end, int flags, uint64_t max, uint64_t min, int* negative, uint64_t* value) {
+	const uint8_t* digits = desc->digits;
+	const char* s = *str;
+	const char* start;
+	const char* sig;
+	uint8_t base = desc->base;
+	int len = desc->chunk_len;
+	uint64_t val = 0;
+	uint64_t limit;
+
+	*negative = 0;
+
+	if ((flags & NUMBER_PARSER_SCAN_SIGN) && s < end && *s == '-') {
+		*negative = 1;
+		s ++;
+	}
+
+	start = s;
+
+	while (s < end && *s == '0') {
+		s ++;
+	}
+
+	sig = s;
+
+	// the value may wrap around, but is not used if there are more than
+	// `safe_len` significant digits
+	while (end - s >= len) {
+		uint64_t chunk = 0;
+		int i;
+
+		for (i = 0; i < len; i ++) {
+			int digit = digits[(uint8_t) s[i]];
+
+			if (digit >= base) {
+				break;
+			}
+
+			chunk = chunk * base + digit;
+		}
+
+		if (i < len) {
+			break;
+		}
+
+		val = val * desc->chunk_mul + chunk;
+		s += len;
+	}
+
+	for (; s < end; s ++) {
+		int digit = digits[(uint8_t) *s];
+
+		if (digit >= base) {
+			break;
+		}
+
+		val = val * base + digit;
+	}
+
+	if (s == start) {
+		return NUMBER_PARSER_ERR_INVALID;
+	}
+
+	*str = s;
+	limit = *negative ? min : max;
+
+	if (s - sig > desc->safe_len || val > limit) {
+		if (!(flags & NUMBER_PARSER_SCAN_SATURATE)) {
+			return NUMBER_PARSER_ERR_RANGE;
+		}
+
+		val = limit;
+	}
+
+	*value = val;
+
+	return NUMBER_PARSER_OK;
+}
+
+/**
+ * Scan a signed integer between -`max` - 1 and `max` with scan_narrow().
+ */
+static int scan_narrow_int(const number_base* desc, const char** str, const char* end, int flags, uint64_t max, int64_t* value) {
+	int negative;
+	uint64_t val;
+	int error = scan_narrow(desc, str, end, flags, max, max + 1, &negative, &val);
+
+	*value = negative ? -(int64_t) val : (int64_t) val;
+
+	return error;
+}
+
+int number_parser_scan_int8(const number_base* desc, const char** str, const char* end, int flags, int8_t* value) {
+	int64_t val;
+	int error = scan_narrow_int(desc, str, end, flags, INT8_MAX, &val);
+
+	if (error == NUMBER_PARSER_OK) {
+		*value = (int8_t) val;
+	}
+
+	return error;
+}
+
+int number_parser_scan_int16(const number_base* desc, const char** str, const char* end, int flags, int16_t* value) {
+	int64_t val;
+	int error = scan_narrow_int(desc, str, end, flags, INT16_MAX, &val);
+
+	if (error == NUMBER_PARSER_OK) {
+		*value = (int16_t) val;
+	}
+
+	return error;
+}
+
+int number_parser_scan_int32(const number_base* desc, const char** str, const char* end, int flags, int32_t* value) {
+	int64_t val;
+	int error = scan_narrow_int(desc, str, end, flags, INT32_MAX, &val);
+
+	if (error == NUMBER_PARSER_OK) {
+		*value = (int32_t) val;
+	}
+
+	return error;
+}
+
+int number_parser_scan_uint8(const number_base* desc, const char** str, const char* end, int flags, uint8_t* value) {
+	int negative;
+	uint64_t val;
+	int error = scan_narrow(desc, str, end, flags & NUMBER_PARSER_SCAN_SATURATE, UINT8_MAX, 0, &negative, &val);
+
+	if (error == NUMBER_PARSER_OK) {
+		*value = (uint8_t) val;
+	}
+
+	return error;
+}
+
+int number_parser_scan_uint16(const number_base* desc, const char** str, const char* end, int flags, uint16_t* value) {
+	int negative;
+	uint64_t val;
+	int error = scan_narrow(desc, str, end, flags & NUMBER_PARSER_SCAN_SATURATE, UINT16_MAX, 0, &negative, &val);
+
+	if (error == NUMBER_PARSER_OK) {
+		*value = (uint16_t) val;
+	}
+
+	return error;
+}
+
+int number_parser_scan_uint32(const number_base* desc, const char** str, const char* end, int flags, uint32_t* value) {
+	int negative;
+	uint64_t val;
+	int error = scan_narrow(desc, str, end, flags & NUMBER_PARSER_SCAN_SATURATE, UINT32_MAX, 0, &negative, &val);
+
+	if (error == NUMBER_PARSER_OK) {
+		*value = (uint32_t) val;
+	}
+
+	return error;
+}
+
+/**
+ * Calculate the greatest common divisor of `a` and `b` with the binary GCD
+ * algorithm. `a` and `b` must not be 0.
+ */
+static uint64_t gcd64(uint64_t a, uint64_t b) {
+	int shift = number_ctz64(a | b);
+
+	a >>= number_ctz64(a);
+
+	do {
+		b >>= number_ctz64(b);
+
+		if (a > b) {
+			uint64_t t = a;
+
+			a = b;
+			b = t;
+		}
+
+		b -= a;
+	}
+	while (b);
+
+	return a << shift;
+}
+
+uint16_t number_parser_end_half(number_parser* parser) {
+	return parser_to_binary16(parser, 10, 15);
+}
+
+uint16_t number_parser_end_bfloat16(number_parser* parser) {
+	return parser_to_binary16(parser, 7, 127);
+}
+
+int number_parser_end_rational(const number_parser* parser, int64_t* num, uint64_t* den) {
+	uint64_t base = parser->base;
+	uint64_t n = parser->uval;
+	uint64_t d = 1;
+	int exp = parser->exp_sign ? -parser->exp_val : parser->exp_val;
+
+	if (parser->is_float) {
+		return NUMBER_PARSER_ERR_RANGE;
+	}
+
+	if (parser->rad_off >= 0) {
+		exp -= parser->int_len - parser->rad_off;
+	}
+	else {
+		exp += parser->zero_len;
+	}
+
+	if (n == 0) {
+		exp = 0;
+	}
+
+	for (; exp > 0; exp --) {
+		if (number_mul_add_overflow(n, base, 0, UINT64_MAX, &n)) {
+			return NUMBER_PARSER_ERR_RANGE;
+		}
+	}
+
+	// cancelling the common factors of `n` and each factor of the
+	// denominator leaves a reduced fraction
+	for (; exp < 0; exp ++) {
+		uint64_t g = gcd64(n, base);
+
+		n /= g;
+
+		if (number_mul_add_overflow(d, base / g, 0, UINT64_MAX, &d)) {
+			return NUMBER_PARSER_ERR_RANGE;
+		}
+	}
+
+	if (n > MAX_POS_INT + parser->sign) {
+		return NUMBER_PARSER_ERR_RANGE;
+	}
+
+	*num = parser->sign ? (int64_t) (0 - n) : (int64_t) n;
+	*den = d;
+
+	return NUMBER_PARSER_OK;
+}
+
+int number_parser_end(number_parser* parser) {
+	int is_exact;
+	uint64_t mant;
+
+	// trailing zeros of an integer are added while it does not overflow
+	if (parser->zero_len && parser->rad_off < 0 && !parser->has_exp && !parser->is_float) {
+		uint64_t value;
+
+		while (parser->zero_len && !number_mul_add_overflow(parser->uval, parser->base, 0, MAX_INT, &value)) {
+			parser->uval = value;
+			parser->int_len ++;
+			parser->zero_len --;
+		}
+	}
+
+	// the mantissa is exact as long as it has not overflowed
+	is_exact = !parser->is_float;
+	mant = parser->uval;
+
+	// As the maximum magnitude of a positive integer is one less than its
+	// negative counterpart, it cannot be represented as a signed integer if
+	// its value is greater or equal as such. So convert to a floating-point
+	// value. Also convert if an exponent or the radix point is set.
+	if ((!parser->sign && parser->uval > MAX_POS_INT)) {
+		convert_to_float(parser, 1);
+	}
+
+	if (parser->has_exp || parser->rad_off >= 0) {
+		convert_to_float(parser, 0);
+	}
+
+	// the remaining trailing zeros overflow the integer
+	if (parser->zero_len) {
+		convert_to_float(parser, 1);
+	}
+
+	if (parser->is_float) {
+		parser->fval = number_float_value(parser, is_exact, mant, parser->desc->pows);
+
+		if (parser->sign) {
+			parser->fval = -parser->fval;
 		}
 	}
 	else if (parser->sign) {
-		parser->ival = -parser->ival;
+		parser->uval = -parser->uval;
 	}
 
 	return parser->is_float;
@@ -75,31 +75,118 @@
 #include <float.h>
 #include <stdint.h>
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 #ifndef DBL_MAX_10_EXP
 #define DBL_MAX_10_EXP 307  ///< The maximum representable decimal exponent.
 #define DBL_MIN_10_EXP -308 ///< The minimum representable decimal exponent.
 #endif
 
+/**
+ * Flags selecting the parts of a number accepted by number_parser_scan().
+ */
+enum {
+	NUMBER_PARSER_SCAN_SIGN         = 1 << 0, ///< Accept a leading `-`.
+	NUMBER_PARSER_SCAN_RAD_POINT    = 1 << 1, ///< Accept a radix point `.`.
+	NUMBER_PARSER_SCAN_EXP          = 1 << 2, ///< Accept an exponent `e` or `E` for bases up to 10.
+	NUMBER_PARSER_SCAN_EXP_REQUIRED = 1 << 3, ///< Require an exponent.
+	NUMBER_PARSER_SCAN_SATURATE     = 1 << 4, ///< Clamp narrow integers out of range to the nearest limit.
+};
+
+/**
+ * Results of the integer-only functions like number_parser_scan_int().
+ */
+enum {
+	NUMBER_PARSER_OK = 0,        ///< The number was parsed.
+	NUMBER_PARSER_ERR_INVALID,   ///< The string does not start with a number.
+	NUMBER_PARSER_ERR_RANGE,     ///< The number is not in the range of the result type.
+};
+
+#define NUMBER_BASE_POWS 12 ///< Number of precomputed powers in `number_base.pows`; exponents are limited to below 2 ^ 12.
+
+/**
+ * Values derived from a number base, which are precomputed once so the parser
+ * does not need to calculate them for each digit.
+ *
+ * Descriptors for all bases are available as static data in `number_bases`.
+ */
+typedef struct {
+	uint64_t max_mul;      ///< Largest mantissa which can be multiplied by `base` without overflow.
+	uint64_t chunk_mul;    ///< `base` ^ `chunk_len`.
+	const uint8_t* digits; ///< Maps characters to digit values; values >= `base` are invalid.
+	const double* pows;    ///< `base` ^ (2 ^ i) used for exponent scaling; NULL for bases which are not scaled by powers or above 36.
+	uint8_t base;          ///< Number base.
+	uint8_t safe_len;      ///< Number of digits which never overflow the mantissa.
+	uint8_t chunk_len;     ///< Number of digits whose value fits into 32 bits.
+} number_base;
+
+/**
+ * Base descriptors indexed by base. Entry 0 and 1 are invalid.
+ */
+extern const number_base number_bases[256];
+
 /**
  * A general purpose number parser.
  */
 typedef struct {
-	int16_t int_len;    ///< Number of digits including integer and fractional part.
+	int16_t int_len;    ///< Number of digits including integer and fractional part, excluding digits dropped from `wide`.
 	int16_t rad_off;    ///< Offset of radix point.
-	int16_t exp_val;    ///< Exponent value.
 	uint8_t base;       ///< Number base.
 	uint8_t sign:1;     ///< Number sign; 0: positive, 1: negative.
 	uint8_t exp_sign:1; ///< Exponent sign; 0: positive, 1: negative.
 	uint8_t is_float:1; ///< Number type; 0: integer, 1: floating-point.
 	uint8_t has_exp:1;  ///< Has exponent.
 	uint8_t was_int:1;  ///< Set to 1 if integer was converted to float because of overflow.
+	uint8_t is_wide:1;  ///< Set to 1 if `wide` holds the mantissa of an overflowed integer.
+	uint8_t is_sticky:1; ///< Set to 1 if a nonzero digit was dropped from `wide`.
+	uint8_t round_up:1; ///< Set to 1 if number_parser_scan() found the dropped digits to round `wide` up to the next double.
 	union {
 		int64_t ival;   ///< Signed integer value.
 		uint64_t uval;  ///< Unsigned integer value.
 		double fval;    ///< Floating-point value.
 	};                  ///< Mantissa containing number value ignoring radix point.
+	const number_base* desc; ///< Base descriptor.
+	uint64_t wide[2];   ///< 128-bit mantissa after the integer overflowed; low word first.
+	int16_t wide_drop;  ///< Number of integer digits dropped from `wide`.
+	int16_t zero_len;   ///< Number of trailing zeros not yet added to the mantissa or `int_len`.
+	int32_t exp_val;    ///< Exponent value; saturates once it overflows or underflows any mantissa.
 } number_parser;
 
+/**
+ * Initialize a base descriptor with the values of `number_bases` for `base`.
+ * This can be used to create a descriptor with a custom digit table.
+ *
+ * @param desc The base descriptor to be initialized.
+ * @param base The number base between 2 and 255.
+ * @param digits A table mapping characters to digit values or NULL to use the
+ * default table, which maps `0-9` and `a-z` or `A-Z` to the values 0 to 35.
+ */
+extern void number_base_init(number_base* desc, uint8_t base, const uint8_t* digits);
+
+/**
+ * Initialize a number parser struct with the base descriptor `desc`.
+ *
+ * @param parser The number parser struct to be initialized.
+ * @param desc The base descriptor, which has to be valid while the parser is
+ * in use.
+ */
+static inline void number_parser_init_base(number_parser* parser, const number_base* desc) {
+#ifdef __cplusplus
+	*parser = number_parser();
+	parser->rad_off = -1;
+	parser->base = desc->base;
+	parser->desc = desc;
+#else
+	*parser = (number_parser) {
+		.base = desc->base,
+		.rad_off = -1,
+		.desc = desc,
+	};
+#endif
+}
+
 /**
  * Initialize a number parser struct with `base`, which can be a value between
  * 2 and 255.
@@ -108,21 +195,47 @@ typedef struct {
  * @param base The number base between 2 and 255.
  */
 static inline void number_parser_init(number_parser* parser, uint8_t base) {
-	*parser = (number_parser) {
-		.base = base,
-		.rad_off = -1,
-	};
+	number_parser_init_base(parser, &number_bases[base]);
 }
 
 /**
  * Add the next integer or fraction `digit`.
- * The number will be converted to floating-point if needed.
+ * The number will be converted to floating-point if needed. Zeros are only
+ * counted in `zero_len` until a nonzero digit follows.
+ *
+ * Only the first 38 significant decimal digits are kept; further digits are
+ * only known to be nonzero, so a number which is close to a halfway point
+ * between two doubles is not always correctly rounded. Use
+ * number_parser_scan() on the whole number to round it exactly.
  *
  * @param parser The number parser to add a digit to.
  * @param digit An integer between 0 and `base` - 1.
  */
 extern void number_parser_add_digit(number_parser* parser, int digit);
 
+/**
+ * Add the digits of the string from `str` to `end` until the first character
+ * which is not a digit in the parser's base. This has the same effect as
+ * calling number_parser_add_digit() for each digit, but combines blocks of
+ * `number_base.chunk_len` digits before adding them to the mantissa. An
+ * overflowed floating-point mantissa is rounded once per block instead of once
+ * per digit.
+ *
+ * Leading zeros are skipped without touching the mantissa. Other runs of zeros
+ * are only counted in `zero_len` until a nonzero digit follows, so zeros at the
+ * end of the number are applied to the exponent by number_parser_end() and do
+ * not overflow the integer mantissa.
+ *
+ * Like with number_parser_add_digit(), decimal numbers with more than 38
+ * significant digits are not always correctly rounded.
+ *
+ * @param parser The number parser to add the digits to.
+ * @param str The start of the string.
+ * @param end The end of the string.
+ * @return A pointer to the first character not consumed.
+ */
+extern const char* number_parser_add_digits(number_parser* parser, const char* str, const char* end);
+
 /**
  * Add the next exponent `digit`.
  * This will convert the number to floating-point.
@@ -139,7 +252,8 @@ extern void number_parser_add_exp_digit(number_parser* parser, int digit);
  * @param parser The number parser to set the radix point for.
  */
 static inline void number_parser_set_rad_point(number_parser* parser) {
-	parser->rad_off = parser->int_len;
+	parser->rad_off = parser->int_len + parser->zero_len;
+	parser->round_up = 0;
 }
 
 /**
@@ -160,8 +274,100 @@ static inline void number_parser_set_neg(number_parser* parser, int negative) {
  */
 static inline void number_parser_set_exp_neg(number_parser* parser, int negative) {
 	parser->exp_sign = negative != 0;
+	parser->round_up = 0;
 }
 
+/**
+ * Scan the number at the beginning of the string from `str` to `end` and feed
+ * it into `parser`.
+ *
+ * Digits are `0-9` and `a-z` or `A-Z` for bases up to 36. The accepted
+ * pattern is selected by `flags`, which is a combination of
+ * `NUMBER_PARSER_SCAN_*` values. At least one integer or fractional digit is
+ * required. An exponent is only consumed if it contains at least one digit.
+ *
+ * If `parser` is fresh, decimal numbers with more significant digits than
+ * `wide` can hold are rounded exactly by number_parser_end(), as the dropped
+ * digits are compared with the halfway point in the string. The decision is
+ * kept in `round_up` without changing the mantissa, and is discarded if more
+ * digits or an exponent are added afterwards.
+ *
+ * @param parser The initialized number parser to feed.
+ * @param str The start of the string.
+ * @param end The end of the string.
+ * @param flags The accepted parts of the number.
+ * @return A pointer to the first character not consumed or `str` if the string
+ * does not start with a number matching `flags`.
+ */
+extern const char* number_parser_scan(number_parser* parser, const char* str, const char* end, int flags);
+
+/**
+ * Scan the integer at the beginning of the string `str` to `end` in the base
+ * of `desc` without using a number parser.
+ *
+ * The number is never converted to floating-point. Only
+ * `NUMBER_PARSER_SCAN_SIGN` is accepted in `flags`; a radix point or an
+ * exponent is never consumed. All digits are consumed even if the number is
+ * out of range.
+ *
+ * @param desc The base descriptor.
+ * @param str The start of the string. Is set to the first character not
+ * consumed if the string starts with a number.
+ * @param end The end of the string.
+ * @param flags The accepted parts of the number.
+ * @param value The parsed value; unmodified on error.
+ * @return `NUMBER_PARSER_OK`, `NUMBER_PARSER_ERR_INVALID` if the string does
+ * not start with a number or `NUMBER_PARSER_ERR_RANGE` if the number does not
+ * fit into `value`.
+ */
+extern int number_parser_scan_int(const number_base* desc, const char** str, const char* end, int flags, int64_t* value);
+
+/**
+ * Scan the unsigned integer at the beginning of the string `str` to `end` like
+ * number_parser_scan_int(), but with the full range of `uint64_t`. A sign is
+ * not accepted.
+ *
+ * @param desc The base descriptor.
+ * @param str The start of the string. Is set to the first character not
+ * consumed if the string starts with a number.
+ * @param end The end of the string.
+ * @param value The parsed value; unmodified on error.
+ * @return `NUMBER_PARSER_OK`, `NUMBER_PARSER_ERR_INVALID` if the string does
+ * not start with a number or `NUMBER_PARSER_ERR_RANGE` if the number is
+ * greater than `UINT64_MAX`.
+ */
+extern int number_parser_scan_uint(const number_base* desc, const char** str, const char* end, uint64_t* value);
+
+/**
+ * Scan the integer at the beginning of the string `str` to `end` into a
+ * narrow integer type like number_parser_scan_int().
+ *
+ * Digits are accumulated without overflow checks. After skipping leading
+ * zeros, numbers with more than `number_base.safe_len` digits are always out
+ * of range, so the range check is a length compare and a single compare
+ * with the limit of the type. With `NUMBER_PARSER_SCAN_SATURATE` in `flags`,
+ * numbers out of range are set to the nearest limit of the type and
+ * `NUMBER_PARSER_OK` is returned.
+ *
+ * The unsigned variants accept only `NUMBER_PARSER_SCAN_SATURATE` in `flags`.
+ *
+ * @param desc The base descriptor.
+ * @param str The start of the string. Is set to the first character not
+ * consumed if the string starts with a number.
+ * @param end The end of the string.
+ * @param flags The accepted parts of the number and the range policy.
+ * @param value The parsed value; unmodified on error.
+ * @return `NUMBER_PARSER_OK`, `NUMBER_PARSER_ERR_INVALID` if the string does
+ * not start with a number or `NUMBER_PARSER_ERR_RANGE` if the number does not
+ * fit into `value` and is not saturated.
+ */
+extern int number_parser_scan_int8(const number_base* desc, const char** str, const char* end, int flags, int8_t* value);
+extern int number_parser_scan_int16(const number_base* desc, const char** str, const char* end, int flags, int16_t* value);   ///< @copydoc number_parser_scan_int8()
+extern int number_parser_scan_int32(const number_base* desc, const char** str, const char* end, int flags, int32_t* value);   ///< @copydoc number_parser_scan_int8()
+extern int number_parser_scan_uint8(const number_base* desc, const char** str, const char* end, int flags, uint8_t* value);   ///< @copydoc number_parser_scan_int8()
+extern int number_parser_scan_uint16(const number_base* desc, const char** str, const char* end, int flags, uint16_t* value); ///< @copydoc number_parser_scan_int8()
+extern int number_parser_scan_uint32(const number_base* desc, const char** str, const char* end, int flags, uint32_t* value); ///< @copydoc number_parser_scan_int8()
+
 /**
  * End parser and calculate the final number.
  *
@@ -173,3 +379,77 @@ static inline void number_parser_set_exp_neg(number_parser* parser, int negative
  * value.
  */
 extern int number_parser_end(number_parser* parser);
+
+/**
+ * Scan the decimal number at the beginning of the string from `str` to `end`
+ * like number_parser_scan() with base 10 and store it as `long double`.
+ *
+ * The number is scanned without a number parser, so neither the number of
+ * digits nor the exponent is limited to the range of a `double`. The result is
+ * correctly rounded for numbers with up to 1200 significant digits; further
+ * digits are only taken into account as nonzero remainder.
+ *
+ * @param str The start of the string.
+ * @param end The end of the string.
+ * @param flags The accepted parts of the number.
+ * @param value The parsed value; unmodified if no number was found.
+ * @return A pointer to the first character not consumed or `str` if the string
+ * does not start with a number matching `flags`.
+ */
+extern const char* number_parser_scan_long_double(const char* str, const char* end, int flags, long double* value);
+
+#if defined(__SIZEOF_FLOAT128__)
+/**
+ * Scan the decimal number at the beginning of the string from `str` to `end`
+ * like number_parser_scan_long_double() and store it as `__float128`.
+ *
+ * @param str The start of the string.
+ * @param end The end of the string.
+ * @param flags The accepted parts of the number.
+ * @param value The parsed value; unmodified if no number was found.
+ * @return A pointer to the first character not consumed or `str` if the string
+ * does not start with a number matching `flags`.
+ */
+extern const char* number_parser_scan_float128(const char* str, const char* end, int flags, __float128* value);
+#endif
+
+/**
+ * End parser and round the number to IEEE 754 binary16.
+ *
+ * Decimal numbers and numbers in power-of-two bases are rounded only once from
+ * the exact value, also if the mantissa has overflowed into `wide`. Digits
+ * dropped after 128 bits only count as nonzero like for number_parser_end().
+ * In other bases, the `double` value calculated by number_parser_end() is
+ * rounded.
+ *
+ * @param parser The number parser to terminate.
+ * @return The bits of the binary16 value.
+ */
+extern uint16_t number_parser_end_half(number_parser* parser);
+
+/**
+ * End parser and round the number to bfloat16 like number_parser_end_half().
+ *
+ * @param parser The number parser to terminate.
+ * @return The bits of the bfloat16 value.
+ */
+extern uint16_t number_parser_end_bfloat16(number_parser* parser);
+
+/**
+ * Get the exact value of the parser's number as reduced fraction `num` /
+ * `den` without floating-point operations. This is useful for bases like 3 or
+ * 12, whose fractions are not representable in binary or decimal.
+ *
+ * The parser is not modified and can still be terminated afterwards.
+ *
+ * @param parser The number parser, which must not be terminated.
+ * @param num The numerator including the sign; unmodified on error.
+ * @param den The positive denominator; unmodified on error.
+ * @return `NUMBER_PARSER_OK` or `NUMBER_PARSER_ERR_RANGE` if the mantissa has
+ * overflowed or the numerator or denominator do not fit.
+ */
+extern int number_parser_end_rational(const number_parser* parser, int64_t* num, uint64_t* den);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,651 @@
+/*
+ * Copyright (c) 2016 Simon Schoenenberger
+ * https://github.com/detomon/number_parser
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+/**
+ * @file
+ *
+ * C++ wrapper of the number parser with the base as compile-time constant.
+ *
+ * basic_number_parser has the same state layout and semantics as the C
+ * `number_parser` struct it derives from, so it can be passed to the C
+ * functions. As the base is known at compile time, the overflow threshold,
+ * multiplications and power tables fold to constants and adding digits is
+ * inlined. The header requires C++11.
+ *
+ * The conversion in end() is shared with number_parser_end() through
+ * `number_core.h`. The header is not header-only: the constructor uses the
+ * `number_bases` table and from_chars() calls number_parser_scan(), so the C
+ * library has to be linked.
+ *
+ * With C++17, from_chars() overloads with the same interface as
+ * `std::from_chars()` parse strings with the number parser.
+ *
+ * With C++20, all member functions are `constexpr`, so numbers can be parsed at
+ * compile time. As end() and number_parser_end() run the same code, the same
+ * digits give the same value at compile time, at runtime and with the C
+ * functions.
+ *
+ * @code{.cpp}
+ * number_parsing::basic_number_parser<10> parser;
+ *
+ * // Parse the number "-12.3e4".
+ * parser.add_exp_digit(4);
+ * parser.add_digit(1);
+ * parser.add_digit(2);
+ * parser.set_rad_point();
+ * parser.add_digit(3);
+ * parser.set_neg(true);
+ *
+ * if (parser.end()) {
+ *     printf("float: %lf\n", parser.fval);
+ * }
+ * else {
+ *     printf("int: %lld\n", (long long) parser.ival);
+ * }
+ *
+ * // Parse a string like std::from_chars().
+ * double value;
+ * auto [ptr, ec] = number_parsing::from_chars(str, str + len, value);
+ *
+ * // Parse "0.5" at compile time.
+ * constexpr double half = [] {
+ *     number_parsing::basic_number_parser<10> parser;
+ *
+ *     parser.add_digit(0);
+ *     parser.set_rad_point();
+ *     parser.add_digit(5);
+ *     parser.end();
+ *
+ *     return parser.fval;
+ * }();
+ * @endcode
+ */
+
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+#if __cplusplus >= 201703L
+#include <charconv>
+#include <system_error>
+#endif
+
+#if __cplusplus >= 202002L
+#define NUMBER_PARSER_CONSTEXPR constexpr ///< `constexpr` if supported for all members.
+#else
+#define NUMBER_PARSER_CONSTEXPR
+#endif
+
+#include "number_parser.h"
+#include "number_core.h"
+
+namespace number_parsing {
+
+namespace detail {
+
+/**
+ * Get 2 ^ `n` as constant expression.
+ */
+constexpr double pow2(int n) noexcept {
+	return n < 0 ? 1.0 / pow2(-n) : n == 0 ? 1.0 : (n & 1 ? 2.0 : 1.0) * pow2(n / 2) * pow2(n / 2);
+}
+
+/**
+ * Square `d`, which is at least 1. Overflowing is not allowed in constant
+ * expressions, so the square scaled down by 2 ^ 1024 is checked first.
+ */
+constexpr double square_pos(double d) noexcept {
+	return d >= pow2(512) || (d * pow2(-512)) * (d * pow2(-512)) >= 1.0 ? std::numeric_limits<double>::infinity() : d * d;
+}
+
+/**
+ * Get `d` ^ (2 ^ `i`) by repeated squaring like number_parser_end().
+ */
+constexpr double pow_pow2(double d, int i) noexcept {
+	return i ? pow_pow2(square_pos(d), i - 1) : d;
+}
+
+/**
+ * Powers `Base` ^ (2 ^ i). end() limits the exponent to below 2 ^ 12.
+ */
+template <std::uint8_t Base>
+struct base_pows {
+	double pows[12];
+
+	constexpr base_pows() noexcept : pows{
+		pow_pow2(Base, 0), pow_pow2(Base, 1), pow_pow2(Base, 2), pow_pow2(Base, 3),
+		pow_pow2(Base, 4), pow_pow2(Base, 5), pow_pow2(Base, 6), pow_pow2(Base, 7),
+		pow_pow2(Base, 8), pow_pow2(Base, 9), pow_pow2(Base, 10), pow_pow2(Base, 11),
+	} {}
+};
+
+/**
+ * Returns the number of digits in base `base` which never overflow the
+ * mantissa like `number_base.safe_len`.
+ */
+constexpr int safe_len(std::uint64_t base, std::uint64_t p = 1, int n = 0) noexcept {
+	return p > (static_cast<std::uint64_t>(INT64_MAX) + 1) / base ? n : safe_len(base, p * base, n + 1);
+}
+
+} // namespace detail
+
+/**
+ * A number parser with base `Base`, which can be a value between 2 and 255.
+ */
+template <std::uint8_t Base>
+class basic_number_parser : public number_parser {
+	static_assert(Base >= 2, "base must be between 2 and 255");
+
+	static constexpr std::uint64_t max_int = static_cast<std::uint64_t>(INT64_MAX) + 1;
+	static constexpr std::uint64_t max_mul = max_int / Base;
+	static constexpr int max_exp = 1 << 22;
+	static constexpr int max_len = INT16_MAX;
+	static constexpr int safe_len = detail::safe_len(Base);
+	static constexpr detail::base_pows<Base> pows = {};
+
+	NUMBER_PARSER_CONSTEXPR void convert_to_float(int was_int) noexcept {
+		if (!is_float) {
+			if (was_int) {
+				is_wide = 1;
+				wide[0] = uval;
+				wide[1] = 0;
+			}
+
+			is_float = 1;
+			this->was_int = was_int;
+			fval = static_cast<double>(uval);
+		}
+	}
+
+	NUMBER_PARSER_CONSTEXPR int add_wide(std::uint64_t mul, std::uint64_t add, int len) noexcept {
+		std::uint64_t lo0 = 0, lo1 = 0, hi0, hi1;
+
+		if (!is_wide) {
+			return len;
+		}
+
+		if (wide[1] >= UINT64_MAX / Base) {
+			is_sticky |= add != 0;
+
+			if (rad_off < 0) {
+				wide_drop = static_cast<std::int16_t>(wide_drop > max_len - len ? max_len : wide_drop + len);
+			}
+
+			return 0;
+		}
+
+		hi0 = detail::number_mul128(wide[0], mul, &lo0);
+		hi1 = detail::number_mul128(wide[1], mul, &lo1);
+		lo0 += add;
+		hi0 += lo0 < add;
+		lo1 += hi0;
+		hi1 += lo1 < hi0;
+
+		wide[0] = lo0;
+		wide[1] = lo1;
+
+		return len;
+	}
+
+	NUMBER_PARSER_CONSTEXPR void add_mant_digit(int digit) noexcept {
+		// fewer digits than `safe_len` cannot overflow the mantissa
+		if (int_len < safe_len) {
+			uval = uval * Base + digit;
+			int_len ++;
+			return;
+		}
+
+		if (int_len >= max_len) {
+			return;
+		}
+
+		if (!is_float) {
+			// check if there is room for another digit, otherwise convert to float
+			if (uval > max_mul) {
+				convert_to_float(1);
+			}
+		}
+
+		if (!is_float) {
+			uval *= Base;
+
+			// convert to float if integer value is greater than the maximum
+			// representable negative value
+			if (uval > max_int - digit) {
+				convert_to_float(1);
+				add_wide(1, digit, 1);
+			}
+			else {
+				uval += digit;
+			}
+		}
+		else {
+			// an overflowed mantissa is only kept in `wide`
+			int_len = static_cast<std::int16_t>(int_len + add_wide(Base, digit, 1));
+			return;
+		}
+
+		int_len ++;
+	}
+
+	NUMBER_PARSER_CONSTEXPR void count_zeros(int len) noexcept {
+		int max = max_len - int_len;
+
+		zero_len = static_cast<std::int16_t>(zero_len > max - len ? max : zero_len + len);
+	}
+
+	NUMBER_PARSER_CONSTEXPR void add_zeros() noexcept {
+		int len = zero_len;
+
+		zero_len = 0;
+
+		// leading zeros only move the fraction digits
+		if (!is_float && !uval) {
+			if (rad_off >= 0) {
+				int_len = static_cast<std::int16_t>(int_len + len);
+			}
+
+			return;
+		}
+
+		for (; len > 0; len --) {
+			add_mant_digit(0);
+		}
+	}
+
+public:
+	static constexpr std::uint8_t base_value = Base; ///< The number base.
+
+	/**
+	 * Initialize the parser like number_parser_init().
+	 */
+	NUMBER_PARSER_CONSTEXPR basic_number_parser() noexcept : number_parser() {
+		uval = 0;
+		rad_off = -1;
+		base = Base;
+		desc = &number_bases[Base];
+	}
+
+	/**
+	 * Add the next integer or fraction `digit` like number_parser_add_digit().
+	 *
+	 * @param digit An integer between 0 and `Base` - 1.
+	 */
+	NUMBER_PARSER_CONSTEXPR void add_digit(int digit) noexcept {
+		// zeros are only counted until a nonzero digit follows
+		if (!digit) {
+			count_zeros(1);
+			return;
+		}
+
+		if (zero_len) {
+			add_zeros();
+		}
+
+		add_mant_digit(digit);
+	}
+
+	/**
+	 * Add the next exponent `digit` like number_parser_add_exp_digit().
+	 *
+	 * @param digit An integer between 0 and `Base` - 1.
+	 */
+	NUMBER_PARSER_CONSTEXPR void add_exp_digit(int digit) noexcept {
+		// ignore large exponent values
+		if (exp_val < max_exp) {
+			exp_val = exp_val * Base + digit;
+			has_exp = 1;
+		}
+	}
+
+	/**
+	 * Set the radix point at the current offset.
+	 */
+	NUMBER_PARSER_CONSTEXPR void set_rad_point() noexcept {
+		rad_off = static_cast<std::int16_t>(int_len + zero_len);
+	}
+
+	/**
+	 * Set the number sign negative.
+	 *
+	 * @param negative A flag indicating that the number should be set to negative.
+	 */
+	NUMBER_PARSER_CONSTEXPR void set_neg(bool negative) noexcept {
+		sign = negative;
+	}
+
+	/**
+	 * Set the exponent sign negative.
+	 *
+	 * @param negative A flag indicating that the exponent should be set to negative.
+	 */
+	NUMBER_PARSER_CONSTEXPR void set_exp_neg(bool negative) noexcept {
+		exp_sign = negative;
+	}
+
+	/**
+	 * End parser and calculate the final number like number_parser_end().
+	 *
+	 * @return `false` if the number is an integer and `true` if the number is
+	 * a floating-point value.
+	 */
+	NUMBER_PARSER_CONSTEXPR bool end() noexcept {
+		// trailing zeros of an integer are added while it does not overflow
+		while (zero_len && rad_off < 0 && !has_exp && !is_float && uval <= max_mul) {
+			uval *= Base;
+			int_len ++;
+			zero_len --;
+		}
+
+		// the mantissa is exact as long as it has not overflowed
+		bool is_exact = !is_float;
+		std::uint64_t mant = is_exact ? uval : 0;
+
+		if (!is_float && !sign && uval > max_int - 1) {
+			convert_to_float(1);
+		}
+
+		if (has_exp || rad_off >= 0) {
+			convert_to_float(0);
+		}
+
+		// the remaining trailing zeros overflow the integer
+		if (zero_len) {
+			convert_to_float(1);
+		}
+
+		if (is_float) {
+			fval = detail::number_float_value(this, is_exact, mant, pows.pows);
+
+			if (sign) {
+				fval = -fval;
+			}
+		}
+		else {
+			if (sign) {
+				uval = -uval;
+			}
+
+			ival = static_cast<std::int64_t>(uval);
+		}
+
+		return is_float;
+	}
+};
+
+#if __cplusplus < 201703L
+template <std::uint8_t Base>
+constexpr detail::base_pows<Base> basic_number_parser<Base>::pows;
+#endif
+
+static_assert(sizeof(basic_number_parser<10>) == sizeof(number_parser), "layout must match number_parser");
+
+#if __cplusplus >= 201703L
+
+namespace detail {
+
+/**
+ * Check if the string from `first` to `last` starts with the lowercase string
+ * `str` ignoring case.
+ */
+inline bool starts_with_nocase(const char* first, const char* last, const char* str) noexcept {
+	for (; *str; first ++, str ++) {
+		if (first == last || (*first | 0x20) != *str) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/**
+ * Scan `inf`, `infinity`, `nan` or `nan(chars)` ignoring case.
+ * Returns `first` if none of them match.
+ */
+inline const char* scan_special(const char* first, const char* last, double& value) noexcept {
+	if (starts_with_nocase(first, last, "inf")) {
+		value = std::numeric_limits<double>::infinity();
+
+		return first + (starts_with_nocase(first, last, "infinity") ? 8 : 3);
+	}
+
+	if (starts_with_nocase(first, last, "nan")) {
+		const char* s = first + 3;
+
+		value = std::numeric_limits<double>::quiet_NaN();
+
+		if (s < last && *s == '(') {
+			const char* p = s + 1;
+
+			for (; p < last && (std::isalnum(static_cast<unsigned char>(*p)) || *p == '_'); p ++) {
+			}
+
+			if (p < last && *p == ')') {
+				s = p + 1;
+			}
+		}
+
+		return s;
+	}
+
+	return first;
+}
+
+} // namespace detail
+
+/**
+ * Parse a floating-point number like `std::from_chars()`.
+ *
+ * `fmt` selects the accepted pattern like for `std::from_chars()`. For
+ * `std::chars_format::hex`, the mantissa has base 16 and the optional exponent
+ * `p` is a decimal power of two; `base` is ignored. The result is correctly
+ * rounded for any number of digits.
+ *
+ * For other formats, digits and exponent have base `base`, which can be a
+ * value between 2 and 36. An exponent `e` is only accepted for bases up to 10.
+ * The result is rounded like by number_parser_scan() and number_parser_end(),
+ * which is exact for decimal numbers and power-of-two bases.
+ *
+ * @param first The start of the string.
+ * @param last The end of the string.
+ * @param value The parsed value; unmodified on error.
+ * @param fmt The accepted number format.
+ * @param base The number base between 2 and 36.
+ * @return A pointer to the first character not consumed and an error code,
+ * which is `std::errc::invalid_argument` if no number was found and
+ * `std::errc::result_out_of_range` if the number is too large or too small.
+ */
+inline std::from_chars_result from_chars(const char* first, const char* last, double& value, std::chars_format fmt = std::chars_format::general, int base = 10) noexcept {
+	number_parser parser;
+	const char* ptr;
+	const char* special;
+	bool is_hex = fmt == std::chars_format::hex;
+	bool has_fixed = (fmt & std::chars_format::fixed) != std::chars_format();
+	bool has_scientific = (fmt & std::chars_format::scientific) != std::chars_format();
+	bool negative = first < last && *first == '-';
+	int flags = NUMBER_PARSER_SCAN_SIGN | NUMBER_PARSER_SCAN_RAD_POINT;
+	double result;
+
+	if ((special = detail::scan_special(first + negative, last, result)) != first + negative) {
+		value = negative ? -result : result;
+
+		return {special, std::errc()};
+	}
+
+	if (is_hex) {
+		base = 16;
+	}
+	else if (has_scientific) {
+		flags |= has_fixed ? NUMBER_PARSER_SCAN_EXP : NUMBER_PARSER_SCAN_EXP_REQUIRED;
+	}
+
+	number_parser_init(&parser, static_cast<std::uint8_t>(base));
+	ptr = number_parser_scan(&parser, first, last, flags);
+
+	if (ptr == first) {
+		return {first, std::errc::invalid_argument};
+	}
+
+	bool is_zero = !parser.is_float && parser.uval == 0;
+
+	if (is_hex) {
+		long exp = 0;
+		const char* p = ptr;
+
+		if (p < last && (*p | 0x20) == 'p') {
+			bool exp_negative = false;
+			const char* digits;
+
+			p ++;
+
+			if (p < last && (*p == '-' || *p == '+')) {
+				exp_negative = *p == '-';
+				p ++;
+			}
+
+			for (digits = p; p < last && *p >= '0' && *p <= '9'; p ++) {
+				// saturate; larger values overflow anyway
+				if (exp < 100000) {
+					exp = exp * 10 + (*p - '0');
+				}
+			}
+
+			if (p > digits) {
+				ptr = p;
+				exp = exp_negative ? -exp : exp;
+			}
+			else {
+				exp = 0;
+			}
+		}
+
+		int top = 0;
+		std::uint64_t mant = 0;
+
+		// an overflowed mantissa is reduced to its top 64 bits and a sticky
+		// bit, so the value is rounded only once
+		if (parser.is_float) {
+			mant = detail::number_wide_mant(parser.wide, parser.is_sticky, &top);
+			exp += 4L * parser.wide_drop;
+		}
+		else if (parser.uval) {
+			top = 63 - detail::number_clz64(parser.uval);
+			mant = parser.uval << (63 - top);
+		}
+
+		if (parser.rad_off >= 0) {
+			exp -= 4L * (parser.int_len - parser.rad_off);
+		}
+		else {
+			exp += 4L * parser.zero_len;
+		}
+
+		// saturate; larger exponents overflow anyway
+		exp += top;
+		exp = exp < -(1L << 14) ? -(1L << 14) : exp > (1L << 14) ? (1L << 14) : exp;
+		result = mant ? detail::number_bits_double(detail::number_round_binary(mant, static_cast<int>(exp), NUMBER_MANT_BITS, 1023)) : 0.0;
+
+		result = parser.sign ? -result : result;
+	}
+	else if (number_parser_end(&parser)) {
+		result = parser.fval;
+	}
+	else {
+		result = static_cast<double>(parser.ival);
+	}
+
+	if (std::isinf(result) || (result == 0.0 && !is_zero)) {
+		return {ptr, std::errc::result_out_of_range};
+	}
+
+	value = parser.sign && result == 0.0 ? -0.0 : result;
+
+	return {ptr, std::errc()};
+}
+
+/**
+ * Parse a signed 64-bit integer like `std::from_chars()`.
+ *
+ * @param first The start of the string.
+ * @param last The end of the string.
+ * @param value The parsed value; unmodified on error.
+ * @param base The number base between 2 and 36.
+ * @return A pointer to the first character not consumed and an error code,
+ * which is `std::errc::invalid_argument` if no number was found and
+ * `std::errc::result_out_of_range` if the number does not fit into `value`.
+ */
+template <typename Int, typename std::enable_if<std::is_integral<Int>::value && std::is_signed<Int>::value && sizeof(Int) == sizeof(std::int64_t), int>::type = 0>
+inline std::from_chars_result from_chars(const char* first, const char* last, Int& value, int base = 10) noexcept {
+	const char* ptr = first;
+	std::int64_t result;
+
+	int error = number_parser_scan_int(&number_bases[base], &ptr, last, NUMBER_PARSER_SCAN_SIGN, &result);
+
+	if (error == NUMBER_PARSER_ERR_INVALID) {
+		return {first, std::errc::invalid_argument};
+	}
+	else if (error == NUMBER_PARSER_ERR_RANGE) {
+		return {ptr, std::errc::result_out_of_range};
+	}
+
+	value = result;
+
+	return {ptr, std::errc()};
+}
+
+/**
+ * Parse an unsigned 64-bit integer like `std::from_chars()`.
+ *
+ * @param first The start of the string.
+ * @param last The end of the string.
+ * @param value The parsed value; unmodified on error.
+ * @param base The number base between 2 and 36.
+ * @return A pointer to the first character not consumed and an error code,
+ * which is `std::errc::invalid_argument` if no number was found and
+ * `std::errc::result_out_of_range` if the number does not fit into `value`.
+ */
+template <typename Int, typename std::enable_if<std::is_integral<Int>::value && std::is_unsigned<Int>::value && sizeof(Int) == sizeof(std::int64_t), int>::type = 0>
+inline std::from_chars_result from_chars(const char* first, const char* last, Int& value, int base = 10) noexcept {
+	const char* ptr = first;
+	std::uint64_t result;
+
+	int error = number_parser_scan_uint(&number_bases[base], &ptr, last, &result);
+
+	if (error == NUMBER_PARSER_ERR_INVALID) {
+		return {first, std::errc::invalid_argument};
+	}
+	else if (error == NUMBER_PARSER_ERR_RANGE) {
+		return {ptr, std::errc::result_out_of_range};
+	}
+
+	value = result;
+
+	return {ptr, std::errc()};
+}
+
+#endif
+
+} // namespace number_parsing
@@ -0,0 +1,223 @@
+/*
+ * Copyright (c) 2016 Simon Schoenenberger
+ * https://github.com/detomon/number_parser
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+/**
+ * @file
+ *
+ * Internal SIMD kernels converting blocks of digits. Each kernel is only
+ * available if the instruction set is enabled at compile time and defines a
+ * corresponding `NUMBER_SIMD_*` macro.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+
+#if defined(__SSE2__) && defined(__GNUC__)
+#include <emmintrin.h>
+
+#define NUMBER_SIMD_POW2 1 ///< number_simd_hex16(), number_simd_oct16() and number_simd_bin16() are available.
+
+/**
+ * Convert the leading hexadecimal digits of the 16 bytes at `str`.
+ *
+ * All 16 bytes have to be readable. The value of the leading digits is stored
+ * in `value`.
+ *
+ * @return The number of leading digits between 0 and 16.
+ */
+static inline int number_simd_hex16(const char* str, uint64_t* value) {
+	__m128i c = _mm_loadu_si128((const __m128i*) str);
+	__m128i l = _mm_or_si128(c, _mm_set1_epi8(0x20));
+
+	// bytes >= 0x80 are negative and are never classified as digits
+	__m128i is_dec = _mm_and_si128(_mm_cmpgt_epi8(c, _mm_set1_epi8('0' - 1)), _mm_cmplt_epi8(c, _mm_set1_epi8('9' + 1)));
+	__m128i is_alpha = _mm_and_si128(_mm_cmpgt_epi8(l, _mm_set1_epi8('a' - 1)), _mm_cmplt_epi8(l, _mm_set1_epi8('f' + 1)));
+	__m128i is_digit = _mm_or_si128(is_dec, is_alpha);
+	unsigned mask = _mm_movemask_epi8(is_digit);
+	int len = __builtin_ctz(~mask); // bit 16 is always clear
+	uint64_t bytes;
+
+	if (len == 0) {
+		return 0;
+	}
+
+	// the low nibble is the digit value for `0-9` and the value - 9 for `a-f`;
+	// non-digits are cleared so they cannot carry into the previous digit
+	__m128i nib = _mm_add_epi8(_mm_and_si128(c, _mm_set1_epi8(0x0F)), _mm_and_si128(is_alpha, _mm_set1_epi8(9)));
+	nib = _mm_and_si128(nib, is_digit);
+
+	// combine pairs of nibbles into bytes with the first digit in the high nibble
+	__m128i pairs = _mm_or_si128(_mm_slli_epi16(_mm_and_si128(nib, _mm_set1_epi16(0x00FF)), 4), _mm_srli_epi16(nib, 8));
+	_mm_storel_epi64((__m128i*) &bytes, _mm_packus_epi16(pairs, pairs));
+
+	// the first digit is in the lowest byte
+	*value = __builtin_bswap64(bytes) >> (64 - len * 4);
+
+	return len;
+}
+
+/**
+ * Convert the leading binary digits of the 16 bytes at `str`.
+ *
+ * All 16 bytes have to be readable. The value of the leading digits is stored
+ * in `value`.
+ *
+ * @return The number of leading digits between 0 and 16.
+ */
+static inline int number_simd_bin16(const char* str, uint64_t* value) {
+	__m128i c = _mm_loadu_si128((const __m128i*) str);
+	__m128i is_one = _mm_cmpeq_epi8(c, _mm_set1_epi8('1'));
+	__m128i is_digit = _mm_or_si128(is_one, _mm_cmpeq_epi8(c, _mm_set1_epi8('0')));
+	unsigned mask = _mm_movemask_epi8(is_digit);
+	unsigned bits = _mm_movemask_epi8(is_one);
+	int len = __builtin_ctz(~mask); // bit 16 is always clear
+
+	if (len == 0) {
+		return 0;
+	}
+
+	// the first digit is in the lowest bit, so reverse the bits
+	bits = ((bits & 0x5555) << 1) | ((bits >> 1) & 0x5555);
+	bits = ((bits & 0x3333) << 2) | ((bits >> 2) & 0x3333);
+	bits = ((bits & 0x0F0F) << 4) | ((bits >> 4) & 0x0F0F);
+	bits = ((bits & 0x00FF) << 8) | (bits >> 8);
+
+	*value = bits >> (16 - len);
+
+	return len;
+}
+
+/**
+ * Convert the leading octal digits of the 16 bytes at `str`.
+ *
+ * All 16 bytes have to be readable. The value of the leading digits is stored
+ * in `value`.
+ *
+ * @return The number of leading digits between 0 and 16.
+ */
+static inline int number_simd_oct16(const char* str, uint64_t* value) {
+	__m128i c = _mm_loadu_si128((const __m128i*) str);
+	__m128i is_digit = _mm_and_si128(_mm_cmpgt_epi8(c, _mm_set1_epi8('0' - 1)), _mm_cmplt_epi8(c, _mm_set1_epi8('7' + 1)));
+	unsigned mask = _mm_movemask_epi8(is_digit);
+	int len = __builtin_ctz(~mask); // bit 16 is always clear
+	uint64_t hi, lo;
+
+	if (len == 0) {
+		return 0;
+	}
+
+	// non-digits are cleared so they cannot carry into the previous digit
+	__m128i d = _mm_and_si128(_mm_sub_epi8(c, _mm_set1_epi8('0')), is_digit);
+
+	// combine 2 digits to 6 bits, 4 digits to 12 bits and 8 digits to 24 bits
+	__m128i p6 = _mm_or_si128(_mm_slli_epi16(_mm_and_si128(d, _mm_set1_epi16(0x00FF)), 3), _mm_srli_epi16(d, 8));
+	__m128i p12 = _mm_madd_epi16(p6, _mm_set1_epi32((1 << 6) | (1 << 16)));
+	__m128i p24 = _mm_madd_epi16(_mm_packs_epi32(p12, p12), _mm_set1_epi32((1 << 12) | (1 << 16)));
+
+	hi = (uint32_t) _mm_cvtsi128_si32(p24);
+	lo = (uint32_t) _mm_cvtsi128_si32(_mm_srli_si128(p24, 4));
+
+	*value = ((hi << 24) | lo) >> (48 - len * 3);
+
+	return len;
+}
+
+#define NUMBER_SIMD_ZEROS 1 ///< number_simd_zeros16() is available.
+
+/**
+ * Count the leading `0` characters of the 16 bytes at `str`.
+ *
+ * All 16 bytes have to be readable.
+ *
+ * @return The number of leading zeros between 0 and 16.
+ */
+static inline int number_simd_zeros16(const char* str) {
+	__m128i c = _mm_loadu_si128((const __m128i*) str);
+	unsigned mask = _mm_movemask_epi8(_mm_cmpeq_epi8(c, _mm_set1_epi8('0')));
+
+	return __builtin_ctz(~mask); // bit 16 is always clear
+}
+#endif // __SSE2__ && __GNUC__
+
+#if defined(__SSSE3__) && defined(__GNUC__)
+#include <tmmintrin.h>
+
+#define NUMBER_SIMD_TOKENS 1 ///< number_simd_tokens16() is available.
+
+/**
+ * Convert up to 4 decimal tokens of 1 to 4 digits at the start of the 16
+ * bytes at `str`, which are each terminated by `delim`.
+ *
+ * All 16 bytes have to be readable. The tokens are gathered into 4 lanes
+ * with a single shuffle and converted in parallel. Token values and lengths
+ * are stored in `values` and `lens`.
+ *
+ * @return The number of converted tokens between 0 and 4. The number of
+ * consumed bytes including the delimiters is stored in `used`.
+ */
+static inline int number_simd_tokens16(const char* str, char delim, uint32_t values[4], uint8_t lens[4], int* used) {
+	__m128i c = _mm_loadu_si128((const __m128i*) str);
+	__m128i is_digit = _mm_and_si128(_mm_cmpgt_epi8(c, _mm_set1_epi8('0' - 1)), _mm_cmplt_epi8(c, _mm_set1_epi8('9' + 1)));
+	unsigned delims = _mm_movemask_epi8(_mm_cmpeq_epi8(c, _mm_set1_epi8(delim)));
+	unsigned valid = delims | _mm_movemask_epi8(is_digit);
+	int pos = 0;
+	int count = 0;
+	uint8_t shuf[16];
+
+	// only tokens consisting of digits and terminated within the block
+	delims &= ~(0xFFFFFFFFu << __builtin_ctz(~valid));
+
+	memset(shuf, 0x80, sizeof(shuf)); // zeroes the missing leading digits
+
+	for (; count < 4 && delims >> pos; count ++) {
+		int end = __builtin_ctz(delims >> pos) + pos;
+		int len = end - pos;
+
+		if (len < 1 || len > 4) {
+			break;
+		}
+
+		// right-align the digits in the lane
+		for (int i = 0; i < len; i ++) {
+			shuf[count * 4 + 4 - len + i] = pos + i;
+		}
+
+		lens[count] = len;
+		pos = end + 1;
+	}
+
+	if (count) {
+		__m128i d = _mm_shuffle_epi8(_mm_sub_epi8(c, _mm_set1_epi8('0')), _mm_loadu_si128((const __m128i*) shuf));
+		__m128i d2 = _mm_maddubs_epi16(d, _mm_set1_epi16(1 << 8 | 10));
+		__m128i d4 = _mm_madd_epi16(d2, _mm_set1_epi32(1 << 16 | 100));
+
+		_mm_storeu_si128((__m128i*) values, d4);
+	}
+
+	*used = pos;
+
+	return count;
+}
+#endif // __SSSE3__ && __GNUC__
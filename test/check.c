@@ -0,0 +1,22 @@
+/**
+ * @file
+ *
+ * Run all regression checks and exit with a nonzero status if any failed.
+ */
+
+#include "check.h"
+
+int check_count;
+int check_failures;
+
+int main(void) {
+	check_format();
+	check_parser();
+	check_ext();
+	check_bigint();
+	check_batch();
+
+	printf("%d checks, %d failures\n", check_count, check_failures);
+
+	return check_failures != 0;
+}
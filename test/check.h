@@ -0,0 +1,222 @@
+/**
+ * @file
+ *
+ * Minimal helpers shared by the regression checks.
+ *
+ * Each `check_*.c` file tests one module of the library. Random inputs are
+ * generated with a fixed seed, so failures are reproducible.
+ */
+
+#pragma once
+
+#include <float.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include "number_parser.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+extern int check_count;    ///< Number of evaluated checks.
+extern int check_failures; ///< Number of failed checks.
+
+/**
+ * Count the check `cond` and print the formatted message if it fails. Only the
+ * first failures are printed.
+ */
+#define CHECK(cond, ...) do { \
+	check_count ++; \
+	if (!(cond)) { \
+		if (check_failures ++ < 20) { \
+			fprintf(stderr, "%s:%d: ", __FILE__, __LINE__); \
+			fprintf(stderr, __VA_ARGS__); \
+			fputc('\n', stderr); \
+		} \
+	} \
+} while (0)
+
+/**
+ * Get the next value of the xorshift generator `state`.
+ */
+static inline uint64_t check_rand(uint64_t* state) {
+	uint64_t x = *state;
+
+	x ^= x << 13;
+	x ^= x >> 7;
+	x ^= x << 17;
+	*state = x;
+
+	return x;
+}
+
+/**
+ * Get the bits of `value`.
+ */
+static inline uint64_t check_bits(double value) {
+	uint64_t bits;
+
+	memcpy(&bits, &value, sizeof(bits));
+
+	return bits;
+}
+
+/**
+ * Scan the number `str` in `base` with all parts accepted and terminate the
+ * parser. Returns the value as `double` including the sign.
+ */
+static inline double check_scan(number_parser* parser, const char* str, int base) {
+	number_parser_init(parser, (uint8_t) base);
+	number_parser_scan(parser, str, str + strlen(str), NUMBER_PARSER_SCAN_SIGN | NUMBER_PARSER_SCAN_RAD_POINT | NUMBER_PARSER_SCAN_EXP);
+
+	if (number_parser_end(parser)) {
+		return parser->fval;
+	}
+
+	return (double) parser->ival;
+}
+
+/**
+ * Feed the number `str` to `parser` one character at a time with
+ * number_parser_add_digit() and the other single-step functions.
+ */
+static inline void check_feed(number_parser* parser, const char* str, int base) {
+	int in_exp = 0;
+
+	number_parser_init(parser, (uint8_t) base);
+
+	for (; *str; str ++) {
+		int c = *str;
+		int digit = c >= '0' && c <= '9' ? c - '0' : c >= 'a' && c <= 'z' ? c - 'a' + 10 : -1;
+
+		if (c == '-') {
+			if (in_exp) {
+				number_parser_set_exp_neg(parser, 1);
+			}
+			else {
+				number_parser_set_neg(parser, 1);
+			}
+		}
+		else if (c == '+') {
+			continue;
+		}
+		else if (c == '.') {
+			number_parser_set_rad_point(parser);
+		}
+		else if (c == 'e' && base <= 10) {
+			in_exp = 1;
+		}
+		else if (in_exp) {
+			number_parser_add_exp_digit(parser, digit);
+		}
+		else {
+			number_parser_add_digit(parser, digit);
+		}
+	}
+}
+
+/**
+ * Write a random decimal number with `digits` significant digits to `buf`.
+ * The radix point, leading and trailing zeros and the exponent are random.
+ */
+static inline void check_rand_decimal(char* buf, uint64_t* state, int digits, int max_exp) {
+	char* s = buf;
+	int point = (int) (check_rand(state) % (digits + 2));
+	int zeros = (int) (check_rand(state) % 4);
+
+	if (check_rand(state) & 1) {
+		*s ++ = '-';
+	}
+
+	if (point == digits + 1) {
+		*s ++ = '0';
+		*s ++ = '.';
+
+		for (int i = 0; i < zeros; i ++) {
+			*s ++ = '0';
+		}
+
+		point = -1;
+	}
+
+	for (int i = 0; i < digits; i ++) {
+		if (i == point) {
+			*s ++ = '.';
+		}
+
+		*s ++ = (char) ('0' + check_rand(state) % 10);
+	}
+
+	if (point == digits) {
+		*s ++ = '.';
+	}
+
+	if (check_rand(state) & 1) {
+		for (int i = 0; i < zeros; i ++) {
+			*s ++ = '0';
+		}
+	}
+
+	if (max_exp) {
+		s += sprintf(s, "e%d", (int) (check_rand(state) % (2 * max_exp + 1)) - max_exp);
+	}
+
+	*s = '\0';
+}
+
+/**
+ * Write the exact decimal midpoint between the positive double `value` and the
+ * next larger double to `buf`, which needs 1200 bytes. If `delta` is positive
+ * or negative, digits are changed and appended to make the number slightly
+ * larger or smaller. Returns 0 if the midpoint cannot be calculated exactly
+ * with `long double`.
+ */
+static inline int check_midpoint(char* buf, double value, int delta) {
+#if LDBL_MANT_DIG >= 64
+	double next = nextafter(value, INFINITY);
+	char exp[16];
+	char* s;
+
+	if (!(value > 0.0) || !isfinite(next)) {
+		return 0;
+	}
+
+	snprintf(buf, 1200, "%.1100Le", ((long double) value + next) / 2);
+	s = strchr(buf, 'e');
+	snprintf(exp, sizeof(exp), "%s", s);
+
+	while (s[-1] == '0') {
+		s --;
+	}
+
+	if (delta > 0) {
+		s += sprintf(s, "000001");
+	}
+	else if (delta < 0) {
+		s[-1] --;
+		s += sprintf(s, "999999");
+	}
+
+	strcpy(s, exp);
+
+	return 1;
+#else
+	(void) buf;
+	(void) value;
+	(void) delta;
+
+	return 0;
+#endif
+}
+
+void check_format(void);
+void check_parser(void);
+void check_ext(void);
+void check_bigint(void);
+void check_batch(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,122 @@
+/**
+ * @file
+ *
+ * Checks of number_batch.h against single number parsers.
+ */
+
+#include <stdlib.h>
+#include "check.h"
+#include "number_batch.h"
+
+#define COUNT 4096
+
+/**
+ * Compare the terminated parsers `batch` with parsers fed separately by
+ * number_parser_scan() from `tokens`.
+ */
+static void compare(number_parser* batch, char tokens[][64], size_t count, int flags, const char* name) {
+	for (size_t i = 0; i < count; i ++) {
+		number_parser parser;
+		const char* str = tokens[i];
+
+		number_parser_init(&parser, 10);
+		number_parser_scan(&parser, str, str + strlen(str), flags);
+		number_parser_end(&parser);
+
+		CHECK(batch[i].is_float == parser.is_float && batch[i].uval == parser.uval, "%s %s: got %s 0x%llx, expected %s 0x%llx", name, str, batch[i].is_float ? "float" : "int", (unsigned long long) batch[i].uval, parser.is_float ? "float" : "int", (unsigned long long) parser.uval);
+	}
+}
+
+/**
+ * Compare the parser states `batch` before termination with parsers fed
+ * separately by number_parser_scan() from `tokens`.
+ */
+static void compare_states(const number_parser* batch, char tokens[][64], size_t count, int flags, const char* name) {
+	for (size_t i = 0; i < count; i ++) {
+		number_parser parser;
+		const char* str = tokens[i];
+		const number_parser* p = &batch[i];
+
+		number_parser_init(&parser, 10);
+		number_parser_scan(&parser, str, str + strlen(str), flags);
+
+		CHECK(p->uval == parser.uval && p->int_len == parser.int_len && p->zero_len == parser.zero_len && p->rad_off == parser.rad_off && p->sign == parser.sign && p->is_float == parser.is_float && p->has_exp == parser.has_exp && p->exp_val == parser.exp_val,
+			"%s %s: got state %llu/%d/%d, expected %llu/%d/%d", name, str, (unsigned long long) p->uval, p->int_len, p->zero_len, (unsigned long long) parser.uval, parser.int_len, parser.zero_len);
+	}
+}
+
+void check_batch(void) {
+	static char tokens[COUNT][64];
+	static char str[COUNT * 64];
+	static number_parser parsers[COUNT];
+	static const char* strs[COUNT];
+	static size_t lens[COUNT];
+	static uint16_t halfs[COUNT];
+	int flags = NUMBER_PARSER_SCAN_SIGN | NUMBER_PARSER_SCAN_RAD_POINT | NUMBER_PARSER_SCAN_EXP;
+	uint64_t state = 0xA54FF53A5F1D36F1u;
+	char* s = str;
+
+	for (size_t i = 0; i < COUNT; i ++) {
+		int kind = (int) (check_rand(&state) % 4);
+
+		// mostly short integers, which take the vectorized paths
+		if (kind < 2) {
+			int len = 1 + (int) (check_rand(&state) % 19);
+			// some integers have many leading and trailing zeros
+			int zeros = check_rand(&state) & 1;
+			char* t = tokens[i];
+
+			if (check_rand(&state) & 1) {
+				*t ++ = '-';
+			}
+
+			for (int j = 0; j < len; j ++) {
+				*t ++ = (char) ('0' + (zeros && check_rand(&state) % 2 ? 0 : check_rand(&state) % 10));
+			}
+
+			*t = '\0';
+		}
+		else {
+			check_rand_decimal(tokens[i], &state, 1 + (int) (check_rand(&state) % 25), kind == 2 ? 20 : 330);
+		}
+
+		strs[i] = tokens[i];
+		lens[i] = strlen(tokens[i]);
+		s += sprintf(s, i ? ",%s" : "%s", tokens[i]);
+	}
+
+	const char* ptr = str;
+	size_t count = number_parser_scan_batch(parsers, COUNT, &number_bases[10], &ptr, s, ',', flags);
+
+	CHECK(count == COUNT && ptr == s, "scan_batch: scanned %zu numbers", count);
+	compare_states(parsers, tokens, count, flags, "scan_batch");
+	number_parser_end_batch(parsers, count);
+	compare(parsers, tokens, count, flags, "scan_batch");
+
+	count = number_parser_scan_tokens(parsers, strs, lens, COUNT, &number_bases[10], flags);
+
+	CHECK(count == COUNT, "scan_tokens: first invalid token %zu", count);
+	compare_states(parsers, tokens, COUNT, flags, "scan_tokens");
+	number_parser_end_batch(parsers, COUNT);
+	compare(parsers, tokens, COUNT, flags, "scan_tokens");
+
+	number_parser_scan_tokens(parsers, strs, lens, COUNT, &number_bases[10], flags);
+	number_parser_end_half_batch(parsers, COUNT, halfs);
+
+	for (size_t i = 0; i < COUNT; i ++) {
+		number_parser parser;
+
+		number_parser_init(&parser, 10);
+		number_parser_scan(&parser, strs[i], strs[i] + lens[i], flags);
+
+		uint16_t half = number_parser_end_half(&parser);
+
+		CHECK(halfs[i] == half, "end_half_batch %s: got 0x%04x, expected 0x%04x", strs[i], halfs[i], half);
+	}
+
+	// a token which is not a number stops the batch
+	ptr = "1,2,x,4";
+	count = number_parser_scan_batch(parsers, COUNT, &number_bases[10], &ptr, ptr + 7, ',', flags);
+
+	CHECK(count == 2, "scan_batch: expected 2 numbers, got %zu", count);
+}
@@ -0,0 +1,134 @@
+/**
+ * @file
+ *
+ * Checks of number_bigint.h against known values and a schoolbook conversion.
+ */
+
+#include <stdlib.h>
+#include "check.h"
+#include "number_bigint.h"
+
+/**
+ * Convert the `len` digits `str` in `base` by multiplying in chunks which fit
+ * into 64 bits. Returns the number of used limbs.
+ */
+static size_t reference(uint64_t* limbs, const char* str, size_t len, int base) {
+	const number_base* desc = &number_bases[base];
+	size_t n = 0;
+	size_t i = 0;
+
+	while (i < len) {
+		uint64_t mul = 1;
+		uint64_t add = 0;
+
+		for (; i < len && mul <= UINT64_MAX / base; i ++) {
+			mul *= base;
+			add = add * base + desc->digits[(uint8_t) str[i]];
+		}
+
+		for (size_t j = 0; j < n; j ++) {
+			unsigned __int128 p = (unsigned __int128) limbs[j] * mul + add;
+
+			limbs[j] = (uint64_t) p;
+			add = (uint64_t) (p >> 64);
+		}
+
+		if (add) {
+			limbs[n ++] = add;
+		}
+	}
+
+	return n;
+}
+
+static void check_bigint_known(void) {
+	static const struct {
+		const char* str;
+		int base;
+		uint8_t sign;
+		size_t len;
+		uint64_t limbs[2];
+	} cases[] = {
+		{"123456789012345678901234567890", 10, 0, 2, {0xc373e0ee4e3f0ad2, 0x18ee90ff6}},
+		{"18446744073709551616", 10, 0, 2, {0, 1}},
+		{"18446744073709551615", 10, 0, 1, {UINT64_MAX}},
+		{"-1", 10, 1, 1, {1}},
+		{"0000", 10, 0, 0, {0}},
+		{"ffffffffffffffffff", 16, 0, 2, {UINT64_MAX, 0xff}},
+		{"-100000000000000000000000000000000000000000000000000000000000000000", 2, 1, 2, {0, 2}},
+		{"3w5e11264sgsf", 36, 0, 1, {UINT64_MAX}},
+	};
+	uint64_t limbs[4];
+	number_bigint big;
+
+	for (size_t i = 0; i < sizeof(cases) / sizeof(*cases); i ++) {
+		const char* str = cases[i].str;
+		const char* end = str + strlen(str);
+
+		number_bigint_init(&big, limbs, 4);
+
+		int error = number_bigint_scan(&big, &number_bases[cases[i].base], &str, end, NUMBER_PARSER_SCAN_SIGN);
+
+		CHECK(error == NUMBER_PARSER_OK && str == end && big.sign == cases[i].sign && big.len == cases[i].len && memcmp(limbs, cases[i].limbs, big.len * sizeof(*limbs)) == 0, "bigint %s base %d: got %d, %zu limbs", cases[i].str, cases[i].base, error, big.len);
+	}
+
+	const char* str = "123456789012345678901234567890";
+
+	number_bigint_init(&big, limbs, 1);
+	CHECK(number_bigint_scan(&big, &number_bases[10], &str, str + strlen(str), 0) == NUMBER_PARSER_ERR_RANGE, "bigint: expected range error");
+
+	str = "x";
+	number_bigint_init(&big, limbs, 4);
+	CHECK(number_bigint_scan(&big, &number_bases[10], &str, str + 1, 0) == NUMBER_PARSER_ERR_INVALID, "bigint: expected invalid error");
+}
+
+/**
+ * Compare random integers of all conversion sizes with the reference,
+ * including the divide and conquer and transform multiplications.
+ */
+static void check_bigint_random(void) {
+	static const size_t lens[] = {1, 19, 20, 100, 599, 601, 5999, 6001, 20000, 200000};
+	static const int bases[] = {10, 7, 36, 16, 2};
+	uint64_t state = 0x3C6EF372FE94F82Bu;
+
+	for (size_t b = 0; b < sizeof(bases) / sizeof(*bases); b ++) {
+		for (size_t l = 0; l < sizeof(lens) / sizeof(*lens); l ++) {
+			int base = bases[b];
+			size_t len = lens[l];
+			size_t cap = number_bigint_limbs(len, (unsigned) base);
+			char* str = malloc(len);
+			uint64_t* limbs = malloc(cap * sizeof(*limbs));
+			uint64_t* ref = malloc(cap * sizeof(*ref));
+			number_bigint big;
+
+			if (base != 10 && len > 20000) {
+				free(str);
+				free(limbs);
+				free(ref);
+				continue;
+			}
+
+			for (size_t i = 0; i < len; i ++) {
+				str[i] = "0123456789abcdefghijklmnopqrstuvwxyz"[check_rand(&state) % base];
+			}
+
+			const char* s = str;
+			size_t ref_len = reference(ref, str, len, base);
+
+			number_bigint_init(&big, limbs, cap);
+
+			int error = number_bigint_scan(&big, &number_bases[base], &s, str + len, 0);
+
+			CHECK(error == NUMBER_PARSER_OK && s == str + len && big.len == ref_len && memcmp(limbs, ref, ref_len * sizeof(*ref)) == 0, "bigint %zu digits base %d: got %d, %zu limbs, expected %zu", len, base, error, big.len, ref_len);
+
+			free(str);
+			free(limbs);
+			free(ref);
+		}
+	}
+}
+
+void check_bigint(void) {
+	check_bigint_known();
+	check_bigint_random();
+}
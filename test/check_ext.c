@@ -0,0 +1,28 @@
+/**
+ * @file
+ *
+ * Checks of number_parser_scan_long_double() against `strtold`.
+ */
+
+#include <math.h>
+#include <stdlib.h>
+#include "check.h"
+
+void check_ext(void) {
+	uint64_t state = 0xBB67AE8584CAA73Bu;
+	static char buf[2048];
+
+	for (int i = 0; i < 100000; i ++) {
+		int digits = (check_rand(&state) & 7) ? 1 + (int) (check_rand(&state) % 40) : 1 + (int) (check_rand(&state) % 1500);
+		int max_exp = (check_rand(&state) & 3) ? 40 : 5000;
+		long double value = 0;
+
+		check_rand_decimal(buf, &state, digits, max_exp);
+
+		const char* end = buf + strlen(buf);
+		const char* ptr = number_parser_scan_long_double(buf, end, NUMBER_PARSER_SCAN_SIGN | NUMBER_PARSER_SCAN_RAD_POINT | NUMBER_PARSER_SCAN_EXP, &value);
+		long double ref = strtold(buf, NULL);
+
+		CHECK(ptr == end && value == ref && signbit(value) == signbit(ref), "%.60s: got %La, expected %La", buf, value, ref);
+	}
+}
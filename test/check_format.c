@@ -0,0 +1,177 @@
+/**
+ * @file
+ *
+ * Checks of number_format.h against the C library.
+ */
+
+#include <math.h>
+#include <stdlib.h>
+#include "check.h"
+#include "number_format.h"
+
+/**
+ * Count the significant digits of a number in positional or scientific
+ * notation, ignoring leading and trailing zeros.
+ */
+static int significant_digits(const char* str) {
+	int count = 0;
+	int zeros = 0;
+	int started = 0;
+
+	for (; *str && *str != 'e'; str ++) {
+		if (*str < '0' || *str > '9') {
+			continue;
+		}
+
+		if (*str == '0') {
+			zeros += started;
+		}
+		else {
+			count += started ? zeros + 1 : 1;
+			zeros = 0;
+			started = 1;
+		}
+	}
+
+	return count;
+}
+
+/**
+ * Get the smallest number of significant digits which round-trip `value`
+ * through `strtod`.
+ */
+static int shortest_digits(double value) {
+	char buf[64];
+
+	for (int prec = 1; prec < 17; prec ++) {
+		snprintf(buf, sizeof(buf), "%.*e", prec - 1, value);
+
+		if (strtod(buf, NULL) == value) {
+			return prec;
+		}
+	}
+
+	return 17;
+}
+
+static void check_format_known(void) {
+	static const struct {
+		double value;
+		const char* str;
+	} cases[] = {
+		{0.3, "0.3"},
+		{1e100, "1e100"},
+		{5.0, "5.0"},
+		{-0.0, "-0.0"},
+		{1.5e-7, "1.5e-7"},
+		{5e-324, "5e-324"},
+		{1.7976931348623157e308, "1.7976931348623157e308"},
+		{INFINITY, "inf"},
+		{-INFINITY, "-inf"},
+	};
+	char buf[NUMBER_FORMAT_DOUBLE_SIZE];
+
+	for (size_t i = 0; i < sizeof(cases) / sizeof(*cases); i ++) {
+		number_format_double(buf, cases[i].value);
+		CHECK(strcmp(buf, cases[i].str) == 0, "format %g: got %s, expected %s", cases[i].value, buf, cases[i].str);
+	}
+
+	number_format_double(buf, NAN);
+	CHECK(strcmp(buf, "nan") == 0, "format nan: got %s", buf);
+
+	number_format_double_fixed(buf, sizeof(buf), 2.675, 2);
+	CHECK(strcmp(buf, "2.67") == 0, "fixed 2.675: got %s", buf);
+
+	number_format_int(buf, -255, 16);
+	CHECK(strcmp(buf, "-ff") == 0, "int -255: got %s", buf);
+
+	number_format_int(buf, INT64_MIN, 10);
+	CHECK(strcmp(buf, "-9223372036854775808") == 0, "int INT64_MIN: got %s", buf);
+}
+
+static void check_format_shortest(void) {
+	uint64_t state = 0x9E3779B97F4A7C15u;
+	char buf[NUMBER_FORMAT_DOUBLE_SIZE];
+	number_parser parser;
+
+	for (int i = 0; i < 200000; i ++) {
+		uint64_t bits = check_rand(&state);
+		double value;
+
+		memcpy(&value, &bits, sizeof(value));
+
+		if (!isfinite(value)) {
+			continue;
+		}
+
+		int len = number_format_double(buf, value);
+		double back = check_scan(&parser, buf, 10);
+
+		CHECK(len == (int) strlen(buf) && len < NUMBER_FORMAT_DOUBLE_SIZE, "format %a: bad length %d", value, len);
+		CHECK(check_bits(back) == bits, "format %a: %s parsed as %a", value, buf, back);
+		CHECK(strtod(buf, NULL) == value, "format %a: %s is not %a for strtod", value, buf, value);
+		CHECK(significant_digits(buf) <= shortest_digits(value), "format %a: %s is not the shortest", value, buf);
+	}
+}
+
+static void check_format_fixed(void) {
+	uint64_t state = 0x2545F4914F6CDD1Du;
+	char buf[512];
+	char ref[512];
+
+	for (int i = 0; i < 100000; i ++) {
+		// values between 2 ^ -40 and 2 ^ 70
+		uint64_t bits = (check_rand(&state) >> 12) | (uint64_t) (983 + check_rand(&state) % 110) << 52;
+		int precision = (int) (check_rand(&state) % 21);
+		double value;
+
+		memcpy(&value, &bits, sizeof(value));
+		value = (check_rand(&state) & 1) ? -value : value;
+
+		int len = number_format_double_fixed(buf, sizeof(buf), value, precision);
+		snprintf(ref, sizeof(ref), "%.*f", precision, value);
+
+		CHECK(len == (int) strlen(buf) && strcmp(buf, ref) == 0, "fixed %a %d: got %s, expected %s", value, precision, buf, ref);
+	}
+
+	// truncated output reports the full length
+	int len = number_format_double_fixed(buf, 4, 12345.5, 1);
+	CHECK(len == 7 && strcmp(buf, "123") == 0, "fixed truncated: got %d %s", len, buf);
+}
+
+static void check_format_int(void) {
+	uint64_t state = 0xD1B54A32D192ED03u;
+	char buf[NUMBER_FORMAT_INT_SIZE];
+	char ref[NUMBER_FORMAT_INT_SIZE];
+
+	for (int i = 0; i < 100000; i ++) {
+		uint64_t value = check_rand(&state) >> (check_rand(&state) % 64);
+		int base = 2 + (int) (check_rand(&state) % 35);
+		int n = NUMBER_FORMAT_INT_SIZE - 1;
+		uint64_t v = value;
+
+		ref[n] = '\0';
+
+		do {
+			ref[-- n] = "0123456789abcdefghijklmnopqrstuvwxyz"[v % base];
+			v /= base;
+		}
+		while (v);
+
+		int len = number_format_uint(buf, value, base);
+		CHECK(len == (int) strlen(buf) && strcmp(buf, &ref[n]) == 0, "uint %llu base %d: got %s, expected %s", (unsigned long long) value, base, buf, &ref[n]);
+
+		const char* str = buf;
+		int64_t back;
+
+		number_format_int(buf, -(int64_t) (value >> 1), base);
+		CHECK(number_parser_scan_int(&number_bases[base], &str, str + strlen(str), NUMBER_PARSER_SCAN_SIGN, &back) == NUMBER_PARSER_OK && back == -(int64_t) (value >> 1), "int -%llu base %d: %s does not round-trip", (unsigned long long) (value >> 1), base, buf);
+	}
+}
+
+void check_format(void) {
+	check_format_known();
+	check_format_shortest();
+	check_format_fixed();
+	check_format_int();
+}
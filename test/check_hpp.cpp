@@ -0,0 +1,360 @@
+/**
+ * @file
+ *
+ * Checks of number_parser.hpp against the C functions and the standard
+ * library. Compiled with several language standards.
+ */
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include "check.h"
+#include "number_parser.hpp"
+
+using number_parsing::basic_number_parser;
+
+int check_count;
+int check_failures;
+
+/**
+ * Feed the number `str` to `parser` like check_feed().
+ */
+template <std::uint8_t Base>
+static double feed(basic_number_parser<Base>& parser, const char* str) {
+	bool in_exp = false;
+
+	for (; *str; str ++) {
+		int c = *str;
+		int digit = c >= '0' && c <= '9' ? c - '0' : c >= 'a' && c <= 'z' ? c - 'a' + 10 : -1;
+
+		if (c == '-') {
+			if (in_exp) {
+				parser.set_exp_neg(true);
+			}
+			else {
+				parser.set_neg(true);
+			}
+		}
+		else if (c == '.') {
+			parser.set_rad_point();
+		}
+		else if (c == 'e' && Base <= 10) {
+			in_exp = true;
+		}
+		else if (in_exp) {
+			parser.add_exp_digit(digit);
+		}
+		else {
+			parser.add_digit(digit);
+		}
+	}
+
+	return parser.end() ? parser.fval : static_cast<double>(parser.ival);
+}
+
+/**
+ * Compare basic_number_parser with the C parser fed digit by digit.
+ */
+template <std::uint8_t Base>
+static void check_parity(std::uint64_t& state, int max_digits, int max_exp, int count) {
+	char buf[128];
+
+	for (int i = 0; i < count; i ++) {
+		basic_number_parser<Base> parser;
+		number_parser ref;
+
+		check_rand_decimal(buf, &state, 1 + static_cast<int>(check_rand(&state) % max_digits), Base == 10 ? max_exp : 0);
+
+		// map the decimal digits to the whole digit range of the base
+		if (Base != 10) {
+			for (char* s = buf; *s; s ++) {
+				if (*s >= '0' && *s <= '9') {
+					*s = "0123456789abcdefghijklmnopqrstuvwxyz"[check_rand(&state) % Base];
+				}
+			}
+		}
+
+		check_feed(&ref, buf, Base);
+		double expected = number_parser_end(&ref) ? ref.fval : static_cast<double>(ref.ival);
+		double value = feed(parser, buf);
+
+		CHECK(check_bits(value) == check_bits(expected) && parser.is_float == ref.is_float, "basic_number_parser<%d> %s: got %a, expected %a", Base, buf, value, expected);
+	}
+}
+
+/**
+ * Compare basic_number_parser fed digit by digit with number_parser_scan() for
+ * long mantissas with runs of zeros.
+ */
+template <std::uint8_t Base>
+static void check_long(std::uint64_t& state, int count) {
+	char buf[256];
+
+	for (int i = 0; i < count; i ++) {
+		basic_number_parser<Base> parser;
+		number_parser ref;
+		int len = 1 + static_cast<int>(check_rand(&state) % 200);
+		int point = static_cast<int>(check_rand(&state) % (len + 1));
+		char* s = buf;
+
+		for (int j = 0; j < len; j ++) {
+			if (j == point) {
+				*s ++ = '.';
+			}
+
+			*s ++ = (check_rand(&state) & 3) ? "0123456789abcdefghijklmnopqrstuvwxyz"[check_rand(&state) % Base] : '0';
+		}
+
+		*s = '\0';
+
+		double expected = check_scan(&ref, buf, Base);
+		double value = feed(parser, buf);
+
+		CHECK(check_bits(value) == check_bits(expected) && parser.is_float == ref.is_float, "long<%d> %s: got %a, expected %a", Base, buf, value, expected);
+	}
+}
+
+/**
+ * Compare basic_number_parser continuing after number_parser_add_digits() with
+ * the C parser, as the counted zeros are shared through `zero_len`.
+ */
+template <std::uint8_t Base>
+static void check_mixed(std::uint64_t& state, int count) {
+	char buf[128];
+
+	for (int i = 0; i < count; i ++) {
+		basic_number_parser<Base> parser;
+		number_parser ref;
+		int len = 1 + static_cast<int>(check_rand(&state) % 40);
+		int split = static_cast<int>(check_rand(&state) % (len + 1));
+		int point = static_cast<int>(check_rand(&state) % (len + 2));
+
+		for (int j = 0; j < len; j ++) {
+			buf[j] = (check_rand(&state) & 1) ? "0123456789abcdefghijklmnopqrstuvwxyz"[check_rand(&state) % Base] : '0';
+		}
+
+		buf[len] = '\0';
+		number_parser_init(&ref, Base);
+
+		number_parser_add_digits(&ref, buf, buf + split);
+		number_parser_add_digits(&parser, buf, buf + split);
+
+		if (point <= split) {
+			number_parser_set_rad_point(&ref);
+			parser.set_rad_point();
+		}
+
+		for (int j = split; j < len; j ++) {
+			int digit = buf[j] <= '9' ? buf[j] - '0' : buf[j] - 'a' + 10;
+
+			number_parser_add_digit(&ref, digit);
+			parser.add_digit(digit);
+		}
+
+		double expected = number_parser_end(&ref) ? ref.fval : static_cast<double>(ref.ival);
+		double value = parser.end() ? parser.fval : static_cast<double>(parser.ival);
+
+		CHECK(check_bits(value) == check_bits(expected) && parser.is_float == ref.is_float, "mixed<%d> %.*s|%s point %d: got %a, expected %a", Base, split, buf, &buf[split], point <= split, value, expected);
+	}
+
+	static const struct {
+		const char* digits;
+		int digit;
+		bool rad_point;
+		double value;
+	} cases[] = {
+		{"1000", -1, false, 1000.0},
+		{"100", 5, false, 1005.0},
+		{"100", 5, true, 100.5},
+		{"000", 5, true, 0.5},
+	};
+
+	for (const auto& c : cases) {
+		basic_number_parser<10> parser;
+
+		number_parser_add_digits(&parser, c.digits, c.digits + std::strlen(c.digits));
+
+		if (c.rad_point) {
+			parser.set_rad_point();
+		}
+
+		if (c.digit >= 0) {
+			parser.add_digit(c.digit);
+		}
+
+		double value = parser.end() ? parser.fval : static_cast<double>(parser.ival);
+
+		CHECK(value == c.value, "mixed %s then %d: got %g, expected %g", c.digits, c.digit, value, c.value);
+	}
+}
+
+#if __cplusplus >= 201703L
+
+/**
+ * Compare from_chars() with `std::from_chars()` for `double`.
+ */
+static void check_from_chars(std::uint64_t& state) {
+	char buf[128];
+
+	for (int i = 0; i < 200000; i ++) {
+		check_rand_decimal(buf, &state, 1 + static_cast<int>(check_rand(&state) % 38), (check_rand(&state) & 3) ? 30 : 340);
+
+		const char* end = buf + std::strlen(buf);
+		double value = 0.0;
+		double expected = 0.0;
+		auto result = number_parsing::from_chars(buf, end, value);
+		auto ref = std::from_chars(buf, end, expected);
+
+		CHECK(result.ptr == ref.ptr && result.ec == ref.ec && (ref.ec != std::errc() || check_bits(value) == check_bits(expected)), "from_chars %s: got %a, expected %a", buf, value, expected);
+	}
+
+	for (int i = 0; i < 200000; i ++) {
+		int len = 1 + static_cast<int>(check_rand(&state) % 40);
+		int frac = static_cast<int>(check_rand(&state) % (len + 1));
+		int exp = static_cast<int>(check_rand(&state) % 2200) - 1100;
+		char digits[48];
+		char* s = buf;
+
+		// long mantissas with runs of zeros and ones test the rounding
+		for (int j = 0; j < len; j ++) {
+			int r = static_cast<int>(check_rand(&state) % 8);
+
+			digits[j] = r == 0 ? '0' : r == 1 ? 'f' : "0123456789abcdef"[check_rand(&state) % 16];
+		}
+
+		if (check_rand(&state) & 1) {
+			*s ++ = '-';
+		}
+
+		std::memcpy(s, digits, static_cast<std::size_t>(len - frac));
+		s += len - frac;
+		*s ++ = '.';
+		std::memcpy(s, &digits[len - frac], static_cast<std::size_t>(frac));
+		s += frac;
+		std::snprintf(s, 16, "p%d", exp);
+
+		const char* end = buf + std::strlen(buf);
+		double value = 0.0;
+		double expected = 0.0;
+		auto result = number_parsing::from_chars(buf, end, value, std::chars_format::hex);
+		auto ref = std::from_chars(buf, end, expected, std::chars_format::hex);
+
+		CHECK(result.ptr == ref.ptr && result.ec == ref.ec && (ref.ec != std::errc() || check_bits(value) == check_bits(expected)), "from_chars hex %s: got %a, expected %a", buf, value, expected);
+	}
+
+	static char mid[1200];
+
+	// midpoints between two doubles have more than 38 digits
+	for (int i = 0; i < 5000; i ++) {
+		std::uint64_t bits = check_rand(&state) >> 1;
+		double d;
+
+		std::memcpy(&d, &bits, sizeof(d));
+
+		for (int delta = -1; delta <= 1 && check_midpoint(mid, d, delta); delta ++) {
+			const char* end = mid + std::strlen(mid);
+			double value = 0.0;
+			double expected = 0.0;
+
+			number_parsing::from_chars(mid, end, value);
+			std::from_chars(mid, end, expected);
+
+			CHECK(check_bits(value) == check_bits(expected), "from_chars %.60s... %+d: got %a, expected %a", mid, delta, value, expected);
+		}
+	}
+
+	const char* hex = "de7c7.f202e9774064b";
+	double hex_value = 0.0;
+	double hex_expected = 0.0;
+
+	number_parsing::from_chars(hex, hex + std::strlen(hex), hex_value, std::chars_format::hex);
+	std::from_chars(hex, hex + std::strlen(hex), hex_expected, std::chars_format::hex);
+
+	CHECK(check_bits(hex_value) == check_bits(hex_expected), "from_chars hex %s: got %a, expected %a", hex, hex_value, hex_expected);
+
+	for (int i = 0; i < 100000; i ++) {
+		int base = 2 + static_cast<int>(check_rand(&state) % 35);
+		std::int64_t expected = static_cast<std::int64_t>(check_rand(&state)) >> (check_rand(&state) % 64);
+		auto res = std::to_chars(buf, buf + sizeof(buf), expected, base);
+		std::int64_t value = 0;
+		auto result = number_parsing::from_chars(buf, res.ptr, value, base);
+
+		CHECK(result.ptr == res.ptr && result.ec == std::errc() && value == expected, "from_chars int %lld base %d: got %lld", static_cast<long long>(expected), base, static_cast<long long>(value));
+	}
+
+	const char* huge = "99999999999999999999";
+	std::uint64_t uvalue = 0;
+	auto result = number_parsing::from_chars(huge, huge + 20, uvalue);
+
+	CHECK(result.ptr == huge + 20 && result.ec == std::errc::result_out_of_range && uvalue == 0, "from_chars uint %s: expected range error", huge);
+}
+
+#endif
+
+#if __cplusplus >= 202002L
+
+constexpr double parse_half() {
+	basic_number_parser<10> parser;
+
+	parser.add_digit(0);
+	parser.set_rad_point();
+	parser.add_digit(5);
+	parser.end();
+
+	return parser.fval;
+}
+
+constexpr double parse_long_hex() {
+	basic_number_parser<16> parser;
+
+	parser.add_digit(1);
+	parser.set_rad_point();
+
+	for (int i = 0; i < 300; i ++) {
+		parser.add_digit(0);
+	}
+
+	parser.end();
+
+	return parser.fval;
+}
+
+constexpr std::int64_t parse_hex() {
+	basic_number_parser<16> parser;
+
+	parser.add_digit(0xf);
+	parser.add_digit(0xf);
+	parser.end();
+
+	return parser.ival;
+}
+
+static_assert(parse_half() == 0.5, "constexpr decimal fraction");
+static_assert(parse_hex() == 255, "constexpr hexadecimal integer");
+static_assert(parse_long_hex() == 1.0, "constexpr long hexadecimal fraction");
+
+#endif
+
+int main() {
+	std::uint64_t state = 0x510E527FADE682D1u;
+
+	check_parity<10>(state, 38, 340, 200000);
+	check_parity<16>(state, 15, 0, 100000);
+	check_parity<2>(state, 60, 0, 100000);
+	check_long<7>(state, 50000);
+	check_long<10>(state, 50000);
+	check_long<16>(state, 50000);
+	check_long<36>(state, 50000);
+	check_mixed<10>(state, 50000);
+	check_mixed<7>(state, 50000);
+	check_mixed<16>(state, 50000);
+
+#if __cplusplus >= 201703L
+	check_from_chars(state);
+#endif
+
+	std::printf("%d checks, %d failures (C++ %ld)\n", check_count, check_failures, static_cast<long>(__cplusplus));
+
+	return check_failures != 0;
+}
@@ -0,0 +1,758 @@
+/**
+ * @file
+ *
+ * Checks of number_parser.h against `strtod` and exact references.
+ */
+
+#include <errno.h>
+#include <math.h>
+#include <stdlib.h>
+#include "check.h"
+#include "number_format.h"
+
+static void check_parser_known(void) {
+	static const struct {
+		const char* str;
+		int base;
+		int is_float;
+		double value;
+	} cases[] = {
+		{"-12.3e4", 10, 1, -123000.0},
+		{"ff", 16, 0, 255.0},
+		{"9223372036854775807", 10, 0, 9223372036854775807.0},
+		{"-9223372036854775808", 10, 0, -9223372036854775808.0},
+		{"9223372036854775808", 10, 1, 9223372036854775808.0},
+		{"0.1", 2, 1, 0.5},
+		{"0.1", 4, 1, 0.25},
+		{"100e-1", 7, 1, 7.0},
+		{"1e400", 10, 1, INFINITY},
+		{"-1e-400", 10, 1, -0.0},
+		{"0.000000000000000000000000000000000000000000001", 10, 1, 1e-45},
+		{"1000000000000000000000000000000000000000000000", 10, 1, 1e45},
+	};
+	number_parser parser;
+
+	for (size_t i = 0; i < sizeof(cases) / sizeof(*cases); i ++) {
+		double value = check_scan(&parser, cases[i].str, cases[i].base);
+
+		CHECK(parser.is_float == cases[i].is_float && check_bits(value) == check_bits(cases[i].value), "%s base %d: got %s %a, expected %a", cases[i].str, cases[i].base, parser.is_float ? "float" : "int", value, cases[i].value);
+
+		check_feed(&parser, cases[i].str, cases[i].base);
+		value = number_parser_end(&parser) ? parser.fval : (double) parser.ival;
+
+		CHECK(check_bits(value) == check_bits(cases[i].value), "%s base %d per digit: got %a, expected %a", cases[i].str, cases[i].base, value, cases[i].value);
+	}
+}
+
+/**
+ * Compare decimal numbers with up to 38 significant digits, whose mantissa is
+ * always exact, with `strtod`.
+ */
+static void check_parser_decimal(void) {
+	uint64_t state = 0x853C49E6748FEA9Bu;
+	char buf[128];
+	number_parser parser;
+
+	for (int i = 0; i < 300000; i ++) {
+		int digits = 1 + (int) (check_rand(&state) % 38);
+		int max_exp = (check_rand(&state) & 3) ? 30 : 340;
+
+		check_rand_decimal(buf, &state, digits, max_exp);
+
+		double ref = strtod(buf, NULL);
+		double value = check_scan(&parser, buf, 10);
+
+		CHECK(check_bits(value) == check_bits(ref), "%s: got %a, expected %a", buf, value, ref);
+
+		check_feed(&parser, buf, 10);
+		value = number_parser_end(&parser) ? parser.fval : (double) parser.ival;
+
+		CHECK(check_bits(value) == check_bits(ref), "%s per digit: got %a, expected %a", buf, value, ref);
+	}
+}
+
+/**
+ * Write `value` in `base` with `frac` fractional digits to `buf`.
+ */
+static void format_fraction(char* buf, uint64_t value, int base, int frac) {
+	char digits[NUMBER_FORMAT_INT_SIZE];
+	int len = number_format_uint(digits, value, base);
+	char* s = buf;
+
+	if (frac >= len) {
+		*s ++ = '0';
+		*s ++ = '.';
+
+		for (int i = len; i < frac; i ++) {
+			*s ++ = '0';
+		}
+
+		memcpy(s, digits, (size_t) len + 1);
+	}
+	else {
+		memcpy(s, digits, (size_t) (len - frac));
+		s += len - frac;
+
+		if (frac) {
+			*s ++ = '.';
+		}
+
+		memcpy(s, &digits[len - frac], (size_t) frac + 1);
+	}
+}
+
+/**
+ * Compare numbers in power-of-two bases with up to 63 bits with hexadecimal
+ * `strtod`, and numbers in other bases whose mantissa and divisor are exact
+ * doubles with a single division.
+ */
+static void check_parser_bases(void) {
+	uint64_t state = 0xDA942042E4DD58B5u;
+	char buf[128];
+	char ref_buf[64];
+	number_parser parser;
+
+	for (int i = 0; i < 200000; i ++) {
+		static const int bits[] = {1, 2, 3, 4, 5};
+		int k = bits[check_rand(&state) % 5];
+		int base = 1 << k;
+		uint64_t value = check_rand(&state) >> (1 + check_rand(&state) % 63);
+		int frac = (int) (check_rand(&state) % 30);
+
+		format_fraction(buf, value, base, frac);
+		snprintf(ref_buf, sizeof(ref_buf), "0x%llxp-%d", (unsigned long long) value, k * frac);
+
+		double ref = strtod(ref_buf, NULL);
+		double result = check_scan(&parser, buf, base);
+
+		CHECK(check_bits(result) == check_bits(ref), "%s base %d: got %a, expected %a", buf, base, result, ref);
+
+		check_feed(&parser, buf, base);
+		result = number_parser_end(&parser) ? parser.fval : (double) parser.ival;
+
+		CHECK(check_bits(result) == check_bits(ref), "%s base %d per digit: got %a, expected %a", buf, base, result, ref);
+	}
+
+	for (int i = 0; i < 200000; i ++) {
+		int base = 3 + (int) (check_rand(&state) % 34);
+		uint64_t value = check_rand(&state) >> (11 + check_rand(&state) % 53);
+		double div = 1.0;
+		int frac = 0;
+
+		if ((base & (base - 1)) == 0) {
+			continue;
+		}
+
+		// keep the divisor exact
+		for (int n = (int) (check_rand(&state) % 12); n > 0 && div * base < 9007199254740992.0; n --) {
+			div *= base;
+			frac ++;
+		}
+
+		format_fraction(buf, value, base, frac);
+
+		double ref = (double) value / div;
+		double result = check_scan(&parser, buf, base);
+
+		CHECK(check_bits(result) == check_bits(ref), "%s base %d: got %a, expected %a", buf, base, result, ref);
+	}
+
+	// the precomputed powers equal the squares computed at runtime
+	for (int base = 2; base < 256; base ++) {
+		const double* pows = number_bases[base].pows;
+		double d = base;
+
+		for (int k = 0; pows && k < NUMBER_BASE_POWS; k ++, d *= d) {
+			CHECK(check_bits(pows[k]) == check_bits(d), "base %d power 2 ^ %d: got %a, expected %a", base, k, pows[k], d);
+		}
+	}
+}
+
+/**
+ * Compare midpoints between two doubles, which have more than 38 digits, and
+ * numbers slightly above and below them with `strtod`.
+ */
+static void check_parser_midpoints(void) {
+	uint64_t state = 0x3C6EF372FE94F82Bu;
+	static char buf[1200];
+	number_parser parser;
+
+	for (int i = 0; i < 20000; i ++) {
+		uint64_t bits = check_rand(&state) >> 1;
+		double value;
+
+		memcpy(&value, &bits, sizeof(value));
+
+		for (int delta = -1; delta <= 1; delta ++) {
+			if (!check_midpoint(buf, value, delta)) {
+				break;
+			}
+
+			double ref = strtod(buf, NULL);
+			double result = check_scan(&parser, buf, 10);
+			number_parser fed;
+
+			CHECK(check_bits(result) == check_bits(ref), "%.60s... %+d: got %a, expected %a", buf, delta, result, ref);
+
+			// the rounding decision of the scan leaves the mantissa as fed
+			// digit by digit, so the 16-bit formats round the same value
+			number_parser_init(&parser, 10);
+			number_parser_scan(&parser, buf, buf + strlen(buf), NUMBER_PARSER_SCAN_RAD_POINT | NUMBER_PARSER_SCAN_EXP);
+			check_feed(&fed, buf, 10);
+			CHECK(parser.wide[0] == fed.wide[0] && parser.wide[1] == fed.wide[1] && number_parser_end_half(&parser) == number_parser_end_half(&fed), "%.60s... %+d: mantissa changed by the scan", buf, delta);
+
+			// the decision for the first part of a split number is discarded
+			if (strchr(buf, 'e') - buf > 40) {
+				number_parser_init(&parser, 10);
+				number_parser_scan(&parser, number_parser_scan(&parser, buf, buf + 40, NUMBER_PARSER_SCAN_RAD_POINT), buf + strlen(buf), NUMBER_PARSER_SCAN_RAD_POINT | NUMBER_PARSER_SCAN_EXP);
+				number_parser_end(&parser);
+				number_parser_end(&fed);
+				CHECK(check_bits(parser.fval) == check_bits(fed.fval), "%.60s... %+d split: got %a, expected %a", buf, delta, parser.fval, fed.fval);
+			}
+		}
+	}
+
+	const char* str = "12.55069025739421828546937831561081111431121826171875";
+	double result = check_scan(&parser, str, 10);
+
+	CHECK(check_bits(result) == check_bits(strtod(str, NULL)), "%s: got %a, expected %a", str, result, strtod(str, NULL));
+}
+
+/**
+ * Compare long mantissas in power-of-two bases with hexadecimal `strtod`,
+ * which reads all digits. Both strings are built from the same random bits.
+ */
+static void check_parser_long_pow2(void) {
+	uint64_t state = 0x1F83D9ABFB41BD6Bu;
+	static char buf[512];
+	static char ref_buf[256];
+	number_parser parser;
+
+	for (int i = 0; i < 100000; i ++) {
+		int k = 1 + (int) (check_rand(&state) % 5);
+		int base = 1 << k;
+		int len = 1 + (int) (check_rand(&state) % (k == 1 ? 300 : 120));
+		int frac = (int) (check_rand(&state) % (len + 1));
+		int bits = len * k;
+		int hex_len = (bits + 3) / 4;
+		uint8_t mant[600] = {0};
+		char* s = buf;
+
+		// random bits with runs of zeros and ones
+		for (int j = 0; j < bits; j ++) {
+			mant[j] = (check_rand(&state) & 7) ? (j ? mant[j - 1] : 1) : check_rand(&state) & 1;
+		}
+
+		for (int j = 0; j < len; j ++) {
+			int digit = 0;
+
+			if (j == len - frac) {
+				*s ++ = '.';
+			}
+
+			for (int b = 0; b < k; b ++) {
+				digit = digit * 2 + mant[j * k + b];
+			}
+
+			*s ++ = "0123456789abcdefghijklmnopqrstuv"[digit];
+		}
+
+		*s = '\0';
+		s = ref_buf + sprintf(ref_buf, "0x");
+
+		// the hexadecimal digits are aligned to the end of the bits
+		for (int j = 0; j < hex_len; j ++) {
+			int digit = 0;
+
+			for (int b = 0; b < 4; b ++) {
+				int bit = j * 4 + b - (hex_len * 4 - bits);
+
+				digit = digit * 2 + (bit >= 0 ? mant[bit] : 0);
+			}
+
+			*s ++ = "0123456789abcdef"[digit];
+		}
+
+		sprintf(s, "p-%d", frac * k);
+
+		double ref = strtod(ref_buf, NULL);
+		double result = check_scan(&parser, buf, base);
+
+		CHECK(check_bits(result) == check_bits(ref), "%s base %d: got %a, expected %a", buf, base, result, ref);
+
+		check_feed(&parser, buf, base);
+		result = number_parser_end(&parser) ? parser.fval : (double) parser.ival;
+
+		CHECK(check_bits(result) == check_bits(ref), "%s base %d per digit: got %a, expected %a", buf, base, result, ref);
+	}
+}
+
+/**
+ * Check that mantissas overflowing 64 bits in any base give the same result
+ * when added in blocks and one by one, and that they never overflow. Other than
+ * in power-of-two bases, the result is not correctly rounded.
+ */
+static void check_parser_long(void) {
+	uint64_t state = 0x5BE0CD19137E2179u;
+	static char buf[512];
+	number_parser parser;
+
+	for (int i = 0; i < 100000; i ++) {
+		int base = 2 + (int) (check_rand(&state) % 35);
+		int len = 1 + (int) (check_rand(&state) % 200);
+		int point = (int) (check_rand(&state) % (len + 1));
+		char* s = buf;
+
+		for (int j = 0; j < len; j ++) {
+			if (j == point) {
+				*s ++ = '.';
+			}
+
+			// runs of zeros are counted separately
+			*s ++ = (check_rand(&state) & 3) ? "0123456789abcdefghijklmnopqrstuvwxyz"[check_rand(&state) % base] : '0';
+		}
+
+		*s = '\0';
+
+		double value = check_scan(&parser, buf, base);
+
+		check_feed(&parser, buf, base);
+		double digits = number_parser_end(&parser) ? parser.fval : (double) parser.ival;
+
+		CHECK(check_bits(value) == check_bits(digits) && value == value, "%s base %d: got %a, per digit %a", buf, base, value, digits);
+	}
+
+	// 1 followed by 300 zeros after the radix point
+	for (int base = 2; base <= 36; base ++) {
+		memset(buf, '0', 302);
+		memcpy(buf, "1.", 2);
+		buf[302] = '\0';
+
+		double value = check_scan(&parser, buf, base);
+		int exact = (base & (base - 1)) == 0;
+
+		CHECK((!exact || value == 1.0) && value > 0.999999999999999 && value < 1.000000000000001, "%.10s... base %d: got %a", buf, base, value);
+
+		check_feed(&parser, buf, base);
+		value = number_parser_end(&parser) ? parser.fval : (double) parser.ival;
+
+		CHECK((!exact || value == 1.0) && value > 0.999999999999999 && value < 1.000000000000001, "%.10s... base %d per digit: got %a", buf, base, value);
+	}
+}
+
+/**
+ * Compare the integer functions with `strtoll` and `strtoull`.
+ */
+static void check_parser_int(void) {
+	uint64_t state = 0x4F1BBCDCBFA53E0Bu;
+	char buf[80];
+
+	for (int i = 0; i < 200000; i ++) {
+		int base = 2 + (int) (check_rand(&state) % 35);
+		int len = 1 + (int) (check_rand(&state) % (base < 8 ? 70 : 22));
+		int negative = check_rand(&state) & 1;
+		char* s = buf;
+
+		if (negative) {
+			*s ++ = '-';
+		}
+
+		for (int j = 0; j < len; j ++) {
+			*s ++ = "0123456789abcdefghijklmnopqrstuvwxyz"[check_rand(&state) % base];
+		}
+
+		*s = '\0';
+
+		const char* str = buf;
+		const char* end = s;
+		int64_t value = 0;
+		int error = number_parser_scan_int(&number_bases[base], &str, end, NUMBER_PARSER_SCAN_SIGN, &value);
+
+		errno = 0;
+		long long ref = strtoll(buf, NULL, base);
+
+		if (errno == ERANGE) {
+			CHECK(error == NUMBER_PARSER_ERR_RANGE && str == end, "scan_int %s base %d: expected range error", buf, base);
+		}
+		else {
+			CHECK(error == NUMBER_PARSER_OK && value == ref && str == end, "scan_int %s base %d: got %lld, expected %lld", buf, base, (long long) value, ref);
+		}
+
+		// narrow types are clamped like saturated scans
+		long long clamped = ref < INT8_MIN ? INT8_MIN : ref > INT8_MAX ? INT8_MAX : ref;
+		int8_t v8 = 0;
+
+		str = buf;
+		error = number_parser_scan_int8(&number_bases[base], &str, end, NUMBER_PARSER_SCAN_SIGN | NUMBER_PARSER_SCAN_SATURATE, &v8);
+		CHECK(error == NUMBER_PARSER_OK && v8 == clamped, "scan_int8 %s base %d: got %d, expected %lld", buf, base, v8, clamped);
+
+		int32_t v32 = 0;
+
+		str = buf;
+		error = number_parser_scan_int32(&number_bases[base], &str, end, NUMBER_PARSER_SCAN_SIGN, &v32);
+
+		if (ref < INT32_MIN || ref > INT32_MAX) {
+			CHECK(error == NUMBER_PARSER_ERR_RANGE, "scan_int32 %s base %d: expected range error", buf, base);
+		}
+		else {
+			CHECK(error == NUMBER_PARSER_OK && v32 == ref, "scan_int32 %s base %d: got %d, expected %lld", buf, base, v32, ref);
+		}
+
+		if (negative) {
+			continue;
+		}
+
+		uint64_t uvalue = 0;
+
+		str = buf;
+		error = number_parser_scan_uint(&number_bases[base], &str, end, &uvalue);
+
+		errno = 0;
+		unsigned long long uref = strtoull(buf, NULL, base);
+		int overflow = errno == ERANGE;
+
+		if (overflow) {
+			CHECK(error == NUMBER_PARSER_ERR_RANGE, "scan_uint %s base %d: expected range error", buf, base);
+		}
+		else {
+			CHECK(error == NUMBER_PARSER_OK && uvalue == uref, "scan_uint %s base %d: got %llu, expected %llu", buf, base, (unsigned long long) uvalue, uref);
+		}
+
+		uint16_t v16 = 0;
+
+		str = buf;
+		error = number_parser_scan_uint16(&number_bases[base], &str, end, NUMBER_PARSER_SCAN_SATURATE, &v16);
+		CHECK(error == NUMBER_PARSER_OK && v16 == (overflow || uref > UINT16_MAX ? UINT16_MAX : uref), "scan_uint16 %s base %d: got %u", buf, base, v16);
+	}
+
+	// the smallest integer is negated without overflowing
+	number_parser parser;
+
+	check_scan(&parser, "-9223372036854775808", 10);
+	CHECK(!parser.is_float && parser.ival == INT64_MIN, "-9223372036854775808: got %lld", (long long) parser.ival);
+}
+
+static void check_parser_rational(void) {
+	static const struct {
+		const char* str;
+		int base;
+		int error;
+		int64_t num;
+		uint64_t den;
+	} cases[] = {
+		{"0.01", 3, NUMBER_PARSER_OK, 1, 9},
+		{"12.5", 10, NUMBER_PARSER_OK, 25, 2},
+		{"-0.1", 12, NUMBER_PARSER_OK, -1, 12},
+		{"1.5e3", 10, NUMBER_PARSER_OK, 1500, 1},
+		{"2.50e-2", 10, NUMBER_PARSER_OK, 1, 40},
+		{"1000", 10, NUMBER_PARSER_OK, 1000, 1},
+		{"0000000000123.4500000", 10, NUMBER_PARSER_OK, 2469, 20},
+		{"1234567890123.45000000", 10, NUMBER_PARSER_OK, 24691357802469, 20},
+		{"1234567890123.450000000", 10, NUMBER_PARSER_OK, 24691357802469, 20},
+		{"-0000672728163912.5000000000000000", 11, NUMBER_PARSER_OK, -20896719846689, 11},
+		{"1e30", 10, NUMBER_PARSER_ERR_RANGE, 0, 0},
+		{"1e-30", 10, NUMBER_PARSER_ERR_RANGE, 0, 0},
+	};
+
+	for (size_t i = 0; i < sizeof(cases) / sizeof(*cases); i ++) {
+		number_parser parser;
+		int64_t num = 0;
+		uint64_t den = 0;
+		const char* str = cases[i].str;
+
+		number_parser_init(&parser, (uint8_t) cases[i].base);
+		number_parser_scan(&parser, str, str + strlen(str), NUMBER_PARSER_SCAN_SIGN | NUMBER_PARSER_SCAN_RAD_POINT | NUMBER_PARSER_SCAN_EXP);
+
+		int error = number_parser_end_rational(&parser, &num, &den);
+
+		CHECK(error == cases[i].error && (error || (num == cases[i].num && den == cases[i].den)), "rational %s base %d: got %d %lld/%llu", str, cases[i].base, error, (long long) num, (unsigned long long) den);
+	}
+}
+
+/**
+ * Get the greatest common divisor of `a` and `b`.
+ */
+static uint64_t gcd(uint64_t a, uint64_t b) {
+	while (b) {
+		uint64_t t = a % b;
+
+		a = b;
+		b = t;
+	}
+
+	return a;
+}
+
+/**
+ * Get the exact rationals of fixed-width numbers, which are padded with
+ * leading and trailing zeros to 16 integer and 16 fractional digits.
+ */
+static void check_parser_fixed_width(void) {
+	uint64_t state = 0x9B05688C2B3E6C1Fu;
+	char buf[128];
+	char digits[NUMBER_FORMAT_INT_SIZE];
+
+	for (int i = 0; i < 100000; i ++) {
+		int base = 2 + (int) (check_rand(&state) % 35);
+		uint64_t den = 1;
+		int frac = 0;
+
+		// keep the numerator below 2 ^ 62
+		while (frac < 16 && den < ((uint64_t) 1 << 30) / base && (check_rand(&state) & 3)) {
+			den *= base;
+			frac ++;
+		}
+
+		uint64_t num = check_rand(&state) % (((uint64_t) 1 << 62) / den) * den + check_rand(&state) % den;
+		int negative = check_rand(&state) & 1;
+		uint64_t ipart = num / den;
+		uint64_t fpart = num % den;
+		int len = number_format_uint(digits, ipart, base);
+		char* s = buf;
+
+		if (negative) {
+			*s ++ = '-';
+		}
+
+		// the integer part of base 2 can be longer than 16 digits
+		for (int j = len; j < 16; j ++) {
+			*s ++ = '0';
+		}
+
+		s += sprintf(s, "%s.", digits);
+		len = number_format_uint(digits, fpart, base);
+
+		for (int j = len; j < frac; j ++) {
+			*s ++ = '0';
+		}
+
+		s += sprintf(s, "%s", frac ? digits : "");
+
+		for (int j = frac; j < 16; j ++) {
+			*s ++ = '0';
+		}
+
+		*s = '\0';
+
+		number_parser parser;
+		int64_t rnum = 0;
+		uint64_t rden = 0;
+		uint64_t g = gcd(num, den);
+
+		number_parser_init(&parser, (uint8_t) base);
+		number_parser_scan(&parser, buf, s, NUMBER_PARSER_SCAN_SIGN | NUMBER_PARSER_SCAN_RAD_POINT);
+
+		int error = number_parser_end_rational(&parser, &rnum, &rden);
+		int64_t expected = (int64_t) (num / g) * (negative ? -1 : 1);
+
+		CHECK(error == NUMBER_PARSER_OK && rnum == expected && rden == den / g, "rational %s base %d: got %d %lld/%llu, expected %lld/%llu", buf, base, error, (long long) rnum, (unsigned long long) rden, (long long) expected, (unsigned long long) (den / g));
+	}
+}
+
+/**
+ * Get the value of the 16-bit float `bits` with `mant_bits` mantissa bits and
+ * exponent bias `bias`.
+ */
+static double binary16_value(uint16_t bits, int mant_bits, int bias) {
+	int e = bits >> mant_bits;
+	int m = bits & ((1 << mant_bits) - 1);
+
+	if (e) {
+		m |= 1 << mant_bits;
+	}
+	else {
+		e = 1;
+	}
+
+	return ldexp(m, e - bias - mant_bits);
+}
+
+/**
+ * Write the exact decimal value of `value` with `len` significant digits to
+ * `buf` and add `delta` to the last digit. Returns 0 if the value has more
+ * than `len` digits.
+ */
+static int format_exact(char* buf, double value, int len, int delta) {
+	char tmp[800];
+	char digits[800];
+	int n = 0;
+	int exp;
+
+	snprintf(tmp, sizeof(tmp), "%.700e", value);
+
+	for (const char* s = tmp; *s != 'e'; s ++) {
+		if (*s >= '0' && *s <= '9') {
+			digits[n ++] = *s;
+		}
+	}
+
+	exp = atoi(strchr(tmp, 'e') + 1);
+
+	while (n > 1 && digits[n - 1] == '0') {
+		n --;
+	}
+
+	if (n > len) {
+		return 0;
+	}
+
+	for (; n < len; n ++) {
+		digits[n] = '0';
+	}
+
+	// the value is positive, so a borrow always stops
+	for (int i = len - 1; delta; i --) {
+		int d = digits[i] - '0' + delta;
+
+		delta = d < 0 ? -1 : d > 9 ? 1 : 0;
+		digits[i] = (char) ('0' + (d + 10) % 10);
+	}
+
+	digits[len] = '\0';
+	sprintf(buf, "%c.%se%d", digits[0], &digits[1], exp);
+
+	return 1;
+}
+
+static void check_parser_binary16_known(void) {
+	static const struct {
+		const char* str;
+		uint16_t half;
+		uint16_t bfloat16;
+	} cases[] = {
+		{"1.00048828125", 0x3c00, 0x3f80},
+		{"1.00048828125000000001", 0x3c01, 0x3f80},
+		{"1.00146484375", 0x3c02, 0x3f80},
+		{"1.0078125000000000000000000000000000000000000001", 0x3c08, 0x3f81},
+		{"65520", 0x7c00, 0x4780},
+		{"0.0000000298023223876953125", 0x0000, 0x3300},
+		{"0.00000002980232238769531250000000001", 0x0001, 0x3300},
+	};
+	number_parser parser;
+
+	for (size_t i = 0; i < sizeof(cases) / sizeof(*cases); i ++) {
+		const char* str = cases[i].str;
+		uint16_t result;
+
+		number_parser_init(&parser, 10);
+		number_parser_scan(&parser, str, str + strlen(str), NUMBER_PARSER_SCAN_RAD_POINT);
+		result = number_parser_end_half(&parser);
+
+		CHECK(result == cases[i].half, "half %s: got 0x%04x, expected 0x%04x", str, result, cases[i].half);
+
+		number_parser_init(&parser, 10);
+		number_parser_scan(&parser, str, str + strlen(str), NUMBER_PARSER_SCAN_RAD_POINT);
+		result = number_parser_end_bfloat16(&parser);
+
+		CHECK(result == cases[i].bfloat16, "bfloat16 %s: got 0x%04x, expected 0x%04x", str, result, cases[i].bfloat16);
+	}
+}
+
+/**
+ * Round exact values, midpoints and numbers slightly above and below
+ * midpoints with `len` significant digits to 16-bit floats. All results are
+ * known exactly. More than 19 digits overflow the integer mantissa.
+ */
+static void check_parser_binary16(int len) {
+	uint64_t state = 0x6A09E667F3BCC909u;
+	char buf[256];
+
+	for (int format = 0; format < 2; format ++) {
+		int mant_bits = format ? 7 : 10;
+		int bias = format ? 127 : 15;
+		int max = format ? 0x7f7f : 0x7bff;
+
+		for (int i = 0; i < 20000; i ++) {
+			uint16_t bits = (uint16_t) (check_rand(&state) % (max + 1));
+			uint16_t even = (bits & 1) ? bits + 1 : bits;
+			double lo = binary16_value(bits, mant_bits, bias);
+			double mid = (lo + binary16_value(bits + 1, mant_bits, bias)) / 2;
+			static const int deltas[] = {0, 1, -1};
+
+			for (int j = 0; j < 3; j ++) {
+				uint16_t expected = deltas[j] > 0 ? bits + 1 : deltas[j] < 0 ? bits : even;
+				number_parser parser;
+				uint16_t result;
+
+				// digits after the 38th are only known to be nonzero, so
+				// longer midpoints cannot be told from values slightly above
+				if ((len > 38 && !format_exact(buf, mid, 38, 0)) || !format_exact(buf, mid, len, deltas[j])) {
+					break;
+				}
+
+				number_parser_init(&parser, 10);
+				number_parser_scan(&parser, buf, buf + strlen(buf), NUMBER_PARSER_SCAN_RAD_POINT | NUMBER_PARSER_SCAN_EXP);
+				result = format ? number_parser_end_bfloat16(&parser) : number_parser_end_half(&parser);
+
+				CHECK(result == expected, "%s %s: got 0x%04x, expected 0x%04x", format ? "bfloat16" : "half", buf, result, expected);
+			}
+
+			if (bits && format_exact(buf, lo, len, 0)) {
+				number_parser parser;
+				uint16_t result;
+
+				number_parser_init(&parser, 10);
+				number_parser_scan(&parser, buf, buf + strlen(buf), NUMBER_PARSER_SCAN_RAD_POINT | NUMBER_PARSER_SCAN_EXP);
+				result = format ? number_parser_end_bfloat16(&parser) : number_parser_end_half(&parser);
+
+				CHECK(result == bits, "%s %s: got 0x%04x, expected 0x%04x", format ? "bfloat16" : "half", buf, result, bits);
+			}
+		}
+	}
+}
+
+/**
+ * Check that custom digit tables are used instead of the vectorized paths for
+ * the default table.
+ */
+static void check_parser_digits(void) {
+	uint8_t upper[256];
+	uint8_t reversed[256];
+	number_base hex;
+	number_base dec;
+	number_parser parser;
+	const char* str = "0123456789abcdef0123";
+
+	memset(upper, 0xFF, sizeof(upper));
+	memset(reversed, 0xFF, sizeof(reversed));
+
+	for (int i = 0; i < 10; i ++) {
+		upper['0' + i] = (uint8_t) i;
+		reversed['0' + i] = (uint8_t) (9 - i);
+	}
+
+	for (int i = 0; i < 6; i ++) {
+		upper['A' + i] = (uint8_t) (10 + i);
+	}
+
+	number_base_init(&hex, 16, upper);
+	number_parser_init_base(&parser, &hex);
+
+	const char* end = number_parser_scan(&parser, str, str + strlen(str), 0);
+
+	CHECK(end == str + 10 && !number_parser_end(&parser) && parser.ival == 0x123456789, "custom hex table: got %lld", (long long) parser.ival);
+
+	number_base_init(&dec, 10, reversed);
+	number_parser_init_base(&parser, &dec);
+	number_parser_scan(&parser, str, str + 10, 0);
+
+	CHECK(!number_parser_end(&parser) && parser.ival == 9876543210, "custom decimal table: got %lld", (long long) parser.ival);
+}
+
+void check_parser(void) {
+	check_parser_known();
+	check_parser_digits();
+	check_parser_decimal();
+	check_parser_midpoints();
+	check_parser_bases();
+	check_parser_long_pow2();
+	check_parser_long();
+	check_parser_int();
+	check_parser_rational();
+	check_parser_fixed_width();
+	check_parser_binary16_known();
+	check_parser_binary16(18);
+	check_parser_binary16(19);
+	check_parser_binary16(25);
+	check_parser_binary16(40);
+}